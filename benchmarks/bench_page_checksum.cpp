@@ -0,0 +1,85 @@
+#include "storage/disk/disk_manager.h"
+#include "storage/page/page_checksum.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace dbengine;
+
+// Cost per 4KB page of CRC32C next to the page read it protects.
+// The file is small enough to stay in the OS page cache, so the read path is
+// measured at its fastest; the checksum share is the worst case.
+
+static const int NUM_PAGES = 1024;
+static const int ROUNDS = 20;
+
+template <typename F>
+double NanosPerPage(F &&body) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        body();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double total = std::chrono::duration<double, std::nano>(end - start).count();
+    return total / (static_cast<double>(ROUNDS) * NUM_PAGES);
+}
+
+int main() {
+    std::remove("bench_checksum.db");
+    DiskManager disk_manager("bench_checksum.db");
+
+    // Fill the file with stamped pages of pseudo-random bytes
+    std::vector<char> page(PAGE_SIZE);
+    uint32_t seed = 12345;
+    for (int i = 0; i < NUM_PAGES; i++) {
+        for (uint32_t b = 0; b < PAGE_SIZE; b++) {
+            seed = seed * 1103515245 + 12345;
+            page[b] = static_cast<char>(seed >> 16);
+        }
+        StampPageChecksum(page.data());
+        disk_manager.WritePage(disk_manager.AllocatePage(), page.data());
+    }
+
+    alignas(PAGE_SIZE) static char buffer[PAGE_SIZE];
+    volatile uint32_t sink = 0;
+
+    double read_only = NanosPerPage([&] {
+        for (int i = 0; i < NUM_PAGES; i++) {
+            disk_manager.ReadPage(i, buffer);
+        }
+    });
+
+    double read_verify = NanosPerPage([&] {
+        for (int i = 0; i < NUM_PAGES; i++) {
+            disk_manager.ReadPage(i, buffer);
+            if (!VerifyPageChecksum(buffer)) {
+                std::cerr << "Checksum mismatch on page " << i << std::endl;
+            }
+        }
+    });
+
+    double crc_dispatch = NanosPerPage([&] {
+        for (int i = 0; i < NUM_PAGES; i++) {
+            sink = sink + Crc32c(buffer, PAGE_CHECKSUM_OFFSET);
+        }
+    });
+
+    double crc_software = NanosPerPage([&] {
+        for (int i = 0; i < NUM_PAGES; i++) {
+            sink = sink + Crc32cSoftware(buffer, PAGE_CHECKSUM_OFFSET);
+        }
+    });
+
+    std::cout << "=== Page Checksum Benchmark (" << NUM_PAGES << " pages x " << ROUNDS << " rounds) ===" << std::endl;
+    std::cout << "Hardware CRC32C: " << (Crc32cHardwareAvailable() ? "yes" : "no") << std::endl;
+    printf("ReadPage                 %8.1f ns/page\n", read_only);
+    printf("ReadPage + verify        %8.1f ns/page  (+%.1f%%)\n", read_verify, 100.0 * (read_verify - read_only) / read_only);
+    printf("Crc32c (dispatched)      %8.1f ns/page\n", crc_dispatch);
+    printf("Crc32c (software)        %8.1f ns/page\n", crc_software);
+
+    std::remove("bench_checksum.db");
+    std::remove("bench_checksum.db.bitmap");
+    return 0;
+}
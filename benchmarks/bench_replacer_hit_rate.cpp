@@ -0,0 +1,129 @@
+#include "storage/buffer/replacer.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace dbengine;
+
+// Hit rates of the replacement policies on synthetic traces, replayed against
+// the replacer alone (no I/O) the way BufferPoolManager drives it: a hit pins,
+// records the access and unpins; a miss takes a free frame or a victim.
+//
+// Point lookups hit a hot set that fits in the pool; the mixed trace interleaves
+// them with bursts of a sequential scan over a table far larger than the pool,
+// like an OLTP load running next to a nightly report.
+
+static const size_t POOL_SIZE = 1024;
+static const page_id_t TABLE_PAGES = 100000;  // Point lookup domain
+static const page_id_t HOT_PAGES = 800;       // Receives HOT_SHARE of the lookups
+static const double HOT_SHARE = 0.9;
+static const page_id_t SCAN_BASE = TABLE_PAGES;  // Scanned table lives after the lookup domain
+static const page_id_t SCAN_PAGES = 50000;
+static const int NUM_LOOKUPS = 200000;
+static const int LOOKUPS_PER_BURST = 1000;
+static const int SCAN_BURST = 2000;
+
+struct Access {
+    page_id_t page_id;
+    bool lookup;
+};
+
+static std::vector<Access> MakeTrace(bool with_scans) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<page_id_t> hot(0, HOT_PAGES - 1);
+    std::uniform_int_distribution<page_id_t> cold(HOT_PAGES, TABLE_PAGES - 1);
+
+    std::vector<Access> trace;
+    page_id_t scan_cursor = 0;
+    for (int i = 0; i < NUM_LOOKUPS; i++) {
+        trace.push_back(Access{coin(rng) < HOT_SHARE ? hot(rng) : cold(rng), true});
+        if (with_scans && (i + 1) % LOOKUPS_PER_BURST == 0) {
+            for (int j = 0; j < SCAN_BURST; j++) {
+                trace.push_back(Access{SCAN_BASE + scan_cursor, false});
+                scan_cursor = (scan_cursor + 1) % SCAN_PAGES;
+            }
+        }
+    }
+    return trace;
+}
+
+struct Result {
+    double lookup_hit_rate;
+    double overall_hit_rate;
+    double nanos_per_access;
+};
+
+static Result Replay(ReplacerType type, const std::vector<Access> &trace) {
+    auto replacer = Replacer::Create(type, POOL_SIZE);
+    std::unordered_map<page_id_t, frame_id_t> page_table;
+    std::vector<page_id_t> frame_pages(POOL_SIZE, INVALID_PAGE_ID);
+    size_t next_free = 0;
+
+    size_t hits = 0;
+    size_t lookups = 0;
+    size_t lookup_hits = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const Access &access : trace) {
+        frame_id_t frame_id;
+        auto it = page_table.find(access.page_id);
+        bool hit = it != page_table.end();
+        if (hit) {
+            frame_id = it->second;
+            replacer->Pin(frame_id);
+        } else if (next_free < POOL_SIZE) {
+            frame_id = static_cast<frame_id_t>(next_free++);
+        } else {
+            if (!replacer->Victim(&frame_id)) {
+                std::cerr << "No victim available" << std::endl;
+                return Result{0, 0, 0};
+            }
+            page_table.erase(frame_pages[frame_id]);
+        }
+        if (!hit) {
+            page_table[access.page_id] = frame_id;
+            frame_pages[frame_id] = access.page_id;
+        }
+        replacer->RecordAccess(frame_id, access.page_id);
+        replacer->Unpin(frame_id);
+
+        hits += hit;
+        if (access.lookup) {
+            lookups++;
+            lookup_hits += hit;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double nanos = std::chrono::duration<double, std::nano>(end - start).count();
+    return Result{100.0 * static_cast<double>(lookup_hits) / static_cast<double>(lookups),
+                  100.0 * static_cast<double>(hits) / static_cast<double>(trace.size()),
+                  nanos / static_cast<double>(trace.size())};
+}
+
+int main() {
+    const ReplacerType types[] = {ReplacerType::LRU, ReplacerType::CLOCK, ReplacerType::LRU_K, ReplacerType::TWO_Q};
+    const struct {
+        const char *name;
+        bool with_scans;
+    } traces[] = {{"point lookups", false}, {"lookups + scans", true}};
+
+    std::cout << "=== Replacer Hit Rate Benchmark (" << POOL_SIZE << " frames, hot set " << HOT_PAGES
+              << " pages, scan bursts of " << SCAN_BURST << " every " << LOOKUPS_PER_BURST << " lookups) ===" << std::endl;
+    for (const auto &trace_spec : traces) {
+        std::vector<Access> trace = MakeTrace(trace_spec.with_scans);
+        std::cout << "\n" << trace_spec.name << " (" << trace.size() << " accesses)" << std::endl;
+        printf("%-8s %12s %12s %12s\n", "policy", "lookup hit%", "overall hit%", "ns/access");
+        for (ReplacerType type : types) {
+            Result result = Replay(type, trace);
+            printf("%-8s %12.2f %12.2f %12.1f\n", Replacer::Create(type, 1)->GetName(),
+                   result.lookup_hit_rate, result.overall_hit_rate, result.nanos_per_access);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "storage/buffer/buffer_pool_manager.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/table_iterator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace dbengine;
+
+// Full scan cost per row of a table that is resident in the buffer pool, so
+// only the per-row work is measured: what a row costs when the page is fetched
+// again for every row (as scans used to), next to the iterator's copying,
+// in-place and page-at-a-time paths.
+
+static const int NUM_ROWS = 200000;
+static const uint32_t ROW_SIZE = 64;
+static const int ROUNDS = 5;
+
+template <typename F>
+double NanosPerRow(F &&scan) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        if (scan() != NUM_ROWS) {
+            std::cerr << "Scan returned the wrong number of rows" << std::endl;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(ROUNDS) * NUM_ROWS);
+}
+
+int main() {
+    std::remove("bench_scan.db");
+    DiskManager disk_manager("bench_scan.db");
+    BufferPoolManager bpm(8192, &disk_manager);
+    TableHeap table_heap(&bpm);
+
+    std::vector<RID> rids(NUM_ROWS);
+    Tuple row;
+    row.Allocate(ROW_SIZE);
+    for (int i = 0; i < NUM_ROWS; i++) {
+        memset(row.GetData(), 0, ROW_SIZE);
+        snprintf(row.GetData(), ROW_SIZE, "row %d", i);
+        table_heap.InsertTuple(row, rids[i]);
+    }
+
+    volatile uint64_t sink = 0;
+
+    // One page fetch per row
+    double per_row_fetch = NanosPerRow([&] {
+        Tuple tuple;
+        int count = 0;
+        for (const RID &rid : rids) {
+            if (table_heap.GetTuple(rid, tuple)) {
+                sink = sink + static_cast<uint8_t>(tuple.GetData()[4]);
+                count++;
+            }
+        }
+        return count;
+    });
+
+    double copied = NanosPerRow([&] {
+        TableIterator iterator(&table_heap, &bpm);
+        Tuple tuple;
+        RID rid;
+        int count = 0;
+        while (iterator.Next(tuple, rid)) {
+            sink = sink + static_cast<uint8_t>(tuple.GetData()[4]);
+            count++;
+        }
+        return count;
+    });
+
+    double viewed = NanosPerRow([&] {
+        TableIterator iterator(&table_heap, &bpm);
+        TupleView view;
+        RID rid;
+        int count = 0;
+        while (iterator.Next(view, rid)) {
+            sink = sink + static_cast<uint8_t>(view.GetData()[4]);
+            count++;
+        }
+        return count;
+    });
+
+    double batched = NanosPerRow([&] {
+        TableIterator iterator(&table_heap, &bpm);
+        std::vector<TupleView> batch;
+        int count = 0;
+        while (iterator.NextBatch(batch) > 0) {
+            for (const TupleView &view : batch) {
+                sink = sink + static_cast<uint8_t>(view.GetData()[4]);
+            }
+            count += static_cast<int>(batch.size());
+        }
+        return count;
+    });
+
+    std::cout << "=== Table Scan Benchmark (" << NUM_ROWS << " rows of " << ROW_SIZE << " bytes, "
+              << table_heap.GetNumPages() << " pages) ===" << std::endl;
+    printf("fetch per row (GetTuple)      %8.1f ns/row\n", per_row_fetch);
+    printf("Next(Tuple &)                 %8.1f ns/row  (%.1fx)\n", copied, per_row_fetch / copied);
+    printf("Next(TupleView &)             %8.1f ns/row  (%.1fx)\n", viewed, per_row_fetch / viewed);
+    printf("NextBatch                     %8.1f ns/row  (%.1fx)\n", batched, per_row_fetch / batched);
+
+    std::remove("bench_scan.db");
+    std::remove("bench_scan.db.bitmap");
+    return 0;
+}
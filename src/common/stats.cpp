@@ -0,0 +1,68 @@
+#include "common/stats.h"
+#include <cstdio>
+
+
+namespace dbengine {
+
+// Duration with a unit that keeps it short: 850ns, 41us, 12ms, 3s
+static std::string FormatNanos(uint64_t nanos) {
+    static const char *UNITS[] = {"ns", "us", "ms", "s"};
+    size_t unit = 0;
+    double value = static_cast<double>(nanos);
+    while (unit < 3 && value >= 1000) {
+        value /= 1000;
+        unit++;
+    }
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), value < 10 && unit > 0 ? "%.1f%s" : "%.0f%s", value, UNITS[unit]);
+    return buffer;
+}
+
+void LatencyHistogram::Record(uint64_t nanos) {
+    size_t bucket = nanos == 0 ? 0 : 63 - static_cast<size_t>(__builtin_clzll(nanos));
+    if (bucket >= NUM_LATENCY_BUCKETS) {
+        bucket = NUM_LATENCY_BUCKETS - 1;
+    }
+    counters_.Add(bucket);
+    counters_.Add(SUM_COUNTER, nanos);
+}
+
+HistogramSnapshot LatencyHistogram::Snapshot() const {
+    HistogramSnapshot snapshot;
+    for (size_t i = 0; i < NUM_LATENCY_BUCKETS; i++) {
+        snapshot.buckets[i] = counters_.Get(i);
+        snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.sum_ns = counters_.Get(SUM_COUNTER);
+    return snapshot;
+}
+
+uint64_t HistogramSnapshot::PercentileNanos(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    // Rank of the sample we are after, 1-based
+    uint64_t rank = static_cast<uint64_t>(percentile / 100 * static_cast<double>(count) + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NUM_LATENCY_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return uint64_t{1} << (i + 1);
+        }
+    }
+    return uint64_t{1} << NUM_LATENCY_BUCKETS;
+}
+
+std::string HistogramSnapshot::ToString() const {
+    if (count == 0) {
+        return "n=0";
+    }
+    return "n=" + std::to_string(count) + " mean=" + FormatNanos(static_cast<uint64_t>(MeanNanos())) +
+           " p50<" + FormatNanos(PercentileNanos(50)) + " p99<" + FormatNanos(PercentileNanos(99)) +
+           " max<" + FormatNanos(PercentileNanos(100));
+}
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 
@@ -8,11 +9,15 @@ namespace dbengine {
     // Page size - typically 4KB
     constexpr uint32_t PAGE_SIZE = 4096;
 
+    // Every page ends with a CRC32C of the bytes before it (see page_checksum.h)
+    constexpr uint32_t PAGE_CHECKSUM_SIZE = sizeof(uint32_t);
+    constexpr uint32_t PAGE_CHECKSUM_OFFSET = PAGE_SIZE - PAGE_CHECKSUM_SIZE;
+
     // Internal B Plus Tree Node page size
-    constexpr int32_t INTERNAL_NODE_SIZE = 500;
+    constexpr int32_t INTERNAL_NODE_SIZE = 336;
 
     // Leaf B Plus Tree Node page size
-    constexpr int32_t LEAF_PAGE_SIZE = 250;  
+    constexpr int32_t LEAF_PAGE_SIZE = 200;  
     
     // B+ Tree Page Types
     constexpr uint32_t LEAF_PAGE_TYPE = 0;
@@ -27,11 +32,22 @@ namespace dbengine {
 
 
 
-    // Type alis for page IDs
-    using page_id_t = int32_t;
+    // Type alis for page IDs. 64-bit so a tablespace can grow past 2^31 pages (8TB).
+    using page_id_t = int64_t;
 
     // Invalid page ID constant
     constexpr page_id_t INVALID_PAGE_ID = -1;
 
+    // Most frames a single buffer pool can grow to (16GB of frames)
+    constexpr size_t MAX_POOL_FRAMES = size_t{1} << 22;
+
+    // Number of contiguous pages reserved at a time for one table heap or index
+    constexpr uint32_t EXTENT_SIZE = 64;
+
+    // Pages per stripe unit when a tablespace spans several files. One extent:
+    // extents of a multi-file tablespace start on a stripe boundary, so an
+    // extent always lives in a single file.
+    constexpr uint32_t TABLESPACE_STRIPE_PAGES = EXTENT_SIZE;
+
 
 } // namespace dbengine
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include "common/config.h"
 
 namespace dbengine {
     /**
@@ -11,9 +12,9 @@ namespace dbengine {
         public:
         RID() : page_id_(-1), slot_num_(-1), generation_(0) {}
 
-        RID(int32_t page_id, int32_t slot_num, uint32_t generation) : page_id_(page_id), slot_num_(slot_num), generation_(generation) {}
+        RID(page_id_t page_id, int32_t slot_num, uint32_t generation) : page_id_(page_id), slot_num_(slot_num), generation_(generation) {}
 
-        int32_t GetPageId() const { return page_id_; }
+        page_id_t GetPageId() const { return page_id_; }
         int32_t GetSlotNum() const { return slot_num_; }
         uint32_t GetGeneration() const { return generation_; }
 
@@ -21,7 +22,7 @@ namespace dbengine {
 
 
         private:
-            int32_t page_id_;
+            page_id_t page_id_;
             int32_t slot_num_;
             uint32_t generation_;
     };
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dbengine {
+
+    // Number of counter stripes; threads are spread over them round-robin
+    static constexpr size_t NUM_STAT_STRIPES = 32;
+
+    // Latency histogram buckets: bucket i counts durations in [2^i, 2^(i+1)) nanoseconds
+    static constexpr size_t NUM_LATENCY_BUCKETS = 40;
+
+    /**
+    * @return the counter stripe of the calling thread, fixed on its first call
+    */
+    inline size_t StatStripe() {
+        static std::atomic<size_t> next_stripe{0};
+        thread_local size_t stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % NUM_STAT_STRIPES;
+        return stripe;
+    }
+
+    /**
+    * StripedCounters is a fixed set of event counters bumped from many threads.
+    *
+    * Every thread adds to its own cache-line-aligned stripe with a relaxed atomic
+    * add, so counting on hot paths never contends or bounces cache lines. Reads sum
+    * the stripes; they are exact once writers are quiet and a close approximation
+    * while they run.
+    */
+    template <size_t NUM_COUNTERS>
+    class StripedCounters {
+        public:
+        inline void Add(size_t counter, uint64_t amount = 1) {
+            stripes_[StatStripe()].values[counter].fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        uint64_t Get(size_t counter) const {
+            uint64_t total = 0;
+            for (const Stripe &stripe : stripes_) {
+                total += stripe.values[counter].load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        private:
+        struct alignas(64) Stripe {
+            std::atomic<uint64_t> values[NUM_COUNTERS] = {};
+        };
+
+        Stripe stripes_[NUM_STAT_STRIPES];
+    };
+
+    /**
+    * Point-in-time copy of a LatencyHistogram.
+    */
+    struct HistogramSnapshot {
+        uint64_t buckets[NUM_LATENCY_BUCKETS] = {};
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+
+        double MeanNanos() const { return count == 0 ? 0 : static_cast<double>(sum_ns) / count; }
+
+        /**
+        * @param percentile in [0, 100]
+        * @return upper bound of the bucket holding that percentile (0 if empty)
+        */
+        uint64_t PercentileNanos(double percentile) const;
+
+        /**
+        * One line summary, e.g. "n=1200 mean=41us p50<64us p99<512us max<2ms"
+        */
+        std::string ToString() const;
+    };
+
+    /**
+    * LatencyHistogram counts durations in power-of-two nanosecond buckets.
+    * Recording is two striped relaxed adds (bucket and running sum).
+    */
+    class LatencyHistogram {
+        public:
+        void Record(uint64_t nanos);
+
+        HistogramSnapshot Snapshot() const;
+
+        private:
+        static constexpr size_t SUM_COUNTER = NUM_LATENCY_BUCKETS;
+
+        StripedCounters<NUM_LATENCY_BUCKETS + 1> counters_;  // Buckets, then the sum
+    };
+
+    /**
+    * Records the lifetime of a scope into a LatencyHistogram.
+    */
+    class ScopedLatency {
+        public:
+        explicit ScopedLatency(LatencyHistogram *histogram)
+            : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+        ~ScopedLatency() {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            histogram_->Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+        ScopedLatency(const ScopedLatency &) = delete;
+        ScopedLatency &operator=(const ScopedLatency &) = delete;
+
+        private:
+        LatencyHistogram *histogram_;
+        std::chrono::steady_clock::time_point start_;
+    };
+}
@@ -11,9 +11,9 @@ class TableHeap;
 
 class ExecutionContext {
 public:
-    ExecutionContext(BufferPoolManager *bpm) : bpm_(bpm) {}
+    ExecutionContext(BufferPool *bpm) : bpm_(bpm) {}
 
-    inline BufferPoolManager* GetBufferPoolManager() { return bpm_; }
+    inline BufferPool* GetBufferPoolManager() { return bpm_; }
 
     void RegisterTable(const std::string &table_name, TableHeap *table_heap, Schema *schema) {
         tables_[table_name] = table_heap;
@@ -37,7 +37,7 @@ public:
     }
 
 private:
-    BufferPoolManager *bpm_;
+    BufferPool *bpm_;
     std::unordered_map<std::string, TableHeap*> tables_;
     std::unordered_map<std::string, Schema*> schemas_;
 };
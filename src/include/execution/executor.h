@@ -1,6 +1,7 @@
 #pragma once
 
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
 #include "execution/execution_context.h"
 
 namespace dbengine {
@@ -16,8 +17,22 @@ public:
 
     virtual bool Next(Tuple &tuple, RID &rid) = 0;
 
+    // Next row as a view, valid until the next call (or until the executor is
+    // destroyed). Scans override this to hand out rows in place, without a copy;
+    // the default views a row produced by Next.
+    virtual bool NextView(TupleView &view, RID &rid) {
+        if (!Next(view_tuple_, rid)) {
+            return false;
+        }
+        view = TupleView(view_tuple_.GetData(), view_tuple_.GetSize(), rid);
+        return true;
+    }
+
 protected:
     ExecutionContext *context_;
+
+private:
+    Tuple view_tuple_;  // Row under the last view of the default NextView
 };
 
 }
@@ -3,6 +3,7 @@
 #include "type/value.h"
 #include "catalog/schema.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
 #include <memory>
 
 namespace dbengine {
@@ -21,7 +22,11 @@ public:
     explicit Expression(ExpressionType type) : type_(type) {}
     virtual ~Expression() = default;
 
-    virtual Value Evaluate(const Tuple &tuple, const Schema *schema) const = 0;
+    virtual Value Evaluate(const TupleView &tuple, const Schema *schema) const = 0;
+
+    Value Evaluate(const Tuple &tuple, const Schema *schema) const {
+        return Evaluate(TupleView(tuple), schema);
+    }
 
     ExpressionType GetType() const { return type_; }
 
@@ -34,7 +39,9 @@ public:
     explicit ColumnExpression(uint32_t col_idx)
         : Expression(ExpressionType::COLUMN_REF), col_idx_(col_idx) {}
 
-    Value Evaluate(const Tuple &tuple, const Schema *schema) const override {
+    using Expression::Evaluate;
+
+    Value Evaluate(const TupleView &tuple, const Schema *schema) const override {
         uint32_t offset = schema->GetColumnOffset(col_idx_);
         const Column &col = schema->GetColumn(col_idx_);
         return Value::DeserializeFrom(
@@ -53,7 +60,9 @@ public:
     explicit ConstantExpression(const Value &value)
         : Expression(ExpressionType::CONSTANT), value_(value) {}
 
-    Value Evaluate(const Tuple & /* tuple */, const Schema * /* schema */) const override {
+    using Expression::Evaluate;
+
+    Value Evaluate(const TupleView & /* tuple */, const Schema * /* schema */) const override {
         return value_;
     }
 
@@ -68,7 +77,9 @@ public:
                         std::unique_ptr<Expression> right)
         : Expression(type), left_(std::move(left)), right_(std::move(right)) {}
 
-    Value Evaluate(const Tuple &tuple, const Schema *schema) const override {
+    using Expression::Evaluate;
+
+    Value Evaluate(const TupleView &tuple, const Schema *schema) const override {
         Value left_val = left_->Evaluate(tuple, schema);
         Value right_val = right_->Evaluate(tuple, schema);
 
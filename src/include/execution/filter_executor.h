@@ -39,6 +39,18 @@ public:
         return false;
     }
 
+    // Rows the predicate rejects are never copied
+    bool NextView(TupleView &view, RID &rid) override {
+        while (child_->NextView(view, rid)) {
+            Value result = predicate_->Evaluate(view, schema_);
+
+            if (result.GetAsInt() != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
 private:
     std::unique_ptr<Executor> child_;
     std::unique_ptr<Expression> predicate_;
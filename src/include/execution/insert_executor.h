@@ -38,23 +38,20 @@ public:
             throw std::runtime_error("Column count mismatch in INSERT");
         }
 
+        // Serialized straight into the caller's tuple, whose buffer is reused row after row
         uint32_t tuple_size = schema_->GetTupleSize();
-        char *data = new char[tuple_size];
-        std::memset(data, 0, tuple_size);
+        tuple.Allocate(tuple_size);
+        std::memset(tuple.GetData(), 0, tuple_size);
 
         for (size_t i = 0; i < row.size(); ++i) {
             uint32_t offset = schema_->GetColumnOffset(i);
-            row[i].SerializeTo(data + offset);
+            row[i].SerializeTo(tuple.GetData() + offset);
         }
 
-        Tuple insert_tuple(data, tuple_size);
-        delete[] data;
-
-        if (!table_->InsertTuple(insert_tuple, rid)) {
+        if (!table_->InsertTuple(tuple, rid)) {
             return false;
         }
 
-        tuple = insert_tuple;
         tuple.SetRID(rid);
         cursor_++;
         return true;
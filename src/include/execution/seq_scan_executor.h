@@ -2,6 +2,7 @@
 
 #include "execution/executor.h"
 #include "storage/table/table_iterator.h"
+#include <algorithm>
 #include <string>
 #include <memory>
 
@@ -20,9 +21,18 @@ public:
             throw std::runtime_error("Table not found: " + table_name_);
         }
 
-        iterator_ = std::make_unique<TableIterator>(
-            table, context_->GetBufferPoolManager()
-        );
+        // A table larger than a quarter of the pool is scanned through a ring of
+        // frames, so the scan doesn't push the rest of the working set out
+        BufferPool *bpm = context_->GetBufferPoolManager();
+        ring_.reset();
+        if (table->GetNumPages() > bpm->GetPoolSize() / 4) {
+            ring_ = bpm->NewScanRing(std::min(ScanRing::DEFAULT_NUM_FRAMES, std::max<size_t>(2, bpm->GetPoolSize() / 4)));
+        }
+
+        // A full scan reads the heap front to back: start reading ahead right away
+        bpm->HintSequential(table->GetFirstPageId(), ring_.get());
+
+        iterator_ = std::make_unique<TableIterator>(table, bpm, ring_.get());
     }
 
     bool Next(Tuple &tuple, RID &rid) override {
@@ -33,8 +43,18 @@ public:
         return iterator_->Next(tuple, rid);
     }
 
+    // Rows in place: the view's page stays pinned until the scan moves past it
+    bool NextView(TupleView &view, RID &rid) override {
+        if (iterator_ == nullptr) {
+            return false;
+        }
+
+        return iterator_->Next(view, rid);
+    }
+
 private:
     std::string table_name_;
+    std::unique_ptr<ScanRing> ring_;  // Declared before iterator_, which uses it
     std::unique_ptr<TableIterator> iterator_;
 };
 
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/config.h"
+#include "storage/page/page.h"
+#include "storage/disk/disk_manager.h"
+#include "storage/buffer/page_guard.h"
+#include "storage/buffer/replacer.h"
+
+namespace dbengine {
+
+    /**
+    * BufferPoolStats is the activity of a buffer pool since construction (see BufferPool::GetStats).
+    */
+    struct BufferPoolStats {
+        uint64_t hits = 0;               // Fetches of pages already in (or being read into) the pool
+        uint64_t misses = 0;             // Fetches that read the page themselves
+        uint64_t pin_waits = 0;          // Hits that waited for a read of the page in flight
+        uint64_t frame_waits = 0;        // Times every frame was pinned and a miss waited for reads to land
+        uint64_t no_frame = 0;           // Fetches and NewPage calls that failed: every frame pinned
+        uint64_t evictions = 0;
+        uint64_t eviction_writes = 0;    // Dirty victims the evicting thread had to write
+        uint64_t background_writes = 0;  // Dirty pages cleaned by the background writer
+        uint64_t flush_writes = 0;       // Pages written by FlushPage and FlushAllPages
+        uint64_t pages_created = 0;      // NewPage
+        uint64_t pages_deleted = 0;      // DeletePage
+        uint64_t prefetched = 0;         // Pages read ahead
+        uint64_t ring_reuses = 0;        // Misses of ring scans that recycled one of the ring's frames
+
+        inline double HitRatio() const {
+            return hits + misses == 0 ? 0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+        }
+
+        /**
+        * Add the counters of another pool (e.g. to total the instances of a ParallelBufferPoolManager).
+        */
+        BufferPoolStats &operator+=(const BufferPoolStats &other);
+
+        /**
+        * Multi-line text dump, one "name value" pair per line.
+        */
+        std::string ToString() const;
+    };
+
+    /**
+    * ScanRing is a small ring of frames private to one bulk read, such as a full
+    * table scan (see BufferPool::NewScanRing).
+    *
+    * Pages the scan misses on are read into the ring's frames, and once the ring
+    * is full each miss recycles the frame the scan used longest ago, provided
+    * nobody pinned it since. The scan thereby takes at most about this many
+    * frames from the rest of the pool, however large the table, and a reporting
+    * scan no longer pushes hot index and table pages out. Pages the scan finds
+    * already resident are used in place and don't enter the ring.
+    *
+    * A ring belongs to one scan at a time and is not thread-safe. It must not
+    * outlive its buffer pool.
+    */
+    class ScanRing {
+        public:
+        explicit ScanRing(size_t num_frames) : num_frames_(num_frames), next_(0) {}
+
+        inline size_t GetNumFrames() const { return num_frames_; }
+
+        // Ring size of a full table scan (128KB of frames)
+        static constexpr size_t DEFAULT_NUM_FRAMES = 32;
+
+        private:
+            friend class BufferPoolManager;
+            friend class ParallelBufferPoolManager;
+
+            // A frame of the ring and the page the scan read into it
+            struct Entry {
+                frame_id_t frame_id;
+                page_id_t page_id;
+            };
+
+            size_t num_frames_;
+            std::vector<Entry> entries_;  // Frames taken so far, at most num_frames_
+            size_t next_;  // Oldest entry, recycled next once the ring is full
+
+            // ParallelBufferPoolManager: one ring per instance
+            std::vector<std::unique_ptr<ScanRing>> parts_;
+    };
+
+    /**
+    * BufferPool is the page cache interface used by tables, indexes and executors.
+    *
+    * BufferPoolManager is a single pool of frames; ParallelBufferPoolManager
+    * partitions pages over several of them. See BufferPoolManager for the
+    * semantics of each call.
+    *
+    * Implementations are safe to call from several threads at once.
+    */
+    class BufferPool {
+        public:
+        virtual ~BufferPool() = default;
+
+        /**
+        * Fetch a page, pinned but not latched.
+        * @return pointer to the page, or nullptr if cannot fetch
+        * @throws std::runtime_error if the page read from disk fails its checksum
+        */
+        virtual Page *FetchPage(page_id_t page_id) = 0;
+
+        /**
+        * Fetch a page and latch it for reading (shared with other readers).
+        * @return a guard holding the pin and the latch; invalid if the page cannot be fetched
+        */
+        virtual ReadPageGuard FetchPageRead(page_id_t page_id) = 0;
+
+        /**
+        * Fetch a page for a bulk read and latch it for reading. A miss reads the page
+        * into one of the ring's frames.
+        * @return a guard holding the pin and the latch; invalid if the page cannot be fetched
+        */
+        virtual ReadPageGuard FetchPageRead(page_id_t page_id, ScanRing *ring) = 0;
+
+        /**
+        * Create a scan ring of num_frames frames (see ScanRing).
+        */
+        virtual std::unique_ptr<ScanRing> NewScanRing(size_t num_frames = ScanRing::DEFAULT_NUM_FRAMES) = 0;
+
+        /**
+        * Fetch a page and latch it for writing (exclusive).
+        * @return a guard holding the pin and the latch; invalid if the page cannot be fetched
+        */
+        virtual WritePageGuard FetchPageWrite(page_id_t page_id) = 0;
+
+        /**
+        * Unpin a page fetched with FetchPage or NewPage.
+        * @return false if page not in buffer or not pinned
+        */
+        virtual bool UnpinPage(page_id_t page_id, bool is_dirty) = 0;
+
+        /**
+        * Flush a page to disk (write if dirty).
+        * @return false if page not in buffer
+        */
+        virtual bool FlushPage(page_id_t page_id) = 0;
+
+        /**
+        * Create a new page, pinned.
+        * @param[out] page_id the id of the new page
+        * @return pointer to the new page, or nullptr if all frames pinned
+        */
+        virtual Page *NewPage(page_id_t *page_id) = 0;
+
+        /**
+        * Create a new page taken from the caller's extent.
+        * @param[out] page_id the id of the new page
+        * @param extent the caller's extent cursor
+        * @return pointer to the new page, or nullptr if all frames pinned
+        */
+        virtual Page *NewPage(page_id_t *page_id, PageExtent *extent) = 0;
+
+        /**
+        * Create a new page, latched for writing and already marked dirty.
+        * @param extent the caller's extent cursor, or nullptr
+        * @return a guard on the new page; invalid if all frames are pinned
+        */
+        virtual WritePageGuard NewPageGuarded(page_id_t *page_id, PageExtent *extent = nullptr) = 0;
+
+        /**
+        * Give the unused pages of the caller's extent back for reuse (owner destroyed).
+        */
+        virtual void ReleaseExtent(PageExtent *extent) = 0;
+
+        /**
+        * Delete a page from the buffer pool and disk.
+        * @return false if page is pinned or doesn't exist
+        */
+        virtual bool DeletePage(page_id_t page_id) = 0;
+
+        /**
+        * Flush all dirty pages (checkpoint).
+        */
+        virtual void FlushAllPages() = 0;
+
+        /**
+        * Start asynchronous reads of pages [page_id, page_id + num_pages) that are not resident.
+        * @return number of reads started
+        */
+        virtual size_t Prefetch(page_id_t page_id, size_t num_pages) = 0;
+
+        /**
+        * Tell the buffer pool that a sequential scan starts at page_id.
+        * @param ring the scan's ring, which then also holds the pages read ahead; or nullptr
+        */
+        virtual void HintSequential(page_id_t page_id, ScanRing *ring = nullptr) = 0;
+
+        /**
+        * @return number of frames in the pool
+        */
+        virtual size_t GetPoolSize() const = 0;
+
+        /**
+        * @return a snapshot of the buffer pool counters
+        */
+        virtual BufferPoolStats GetStats() const = 0;
+    };
+} // namespace dbengine
@@ -1,15 +1,25 @@
 #pragma once
 
-#include <unordered_map>
+#include <atomic>
+#include <condition_variable>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
 #include <vector>
 #include "storage/page/page.h"
 #include "storage/disk/disk_manager.h"
-#include "storage/buffer/lru_replacer.h"
+#include "storage/buffer/buffer_pool.h"
+#include "storage/buffer/replacer.h"
+#include "storage/buffer/page_table.h"
+#include "storage/buffer/page_guard.h"
+#include "storage/buffer/frame_arena.h"
 #include "common/config.h"
+#include "common/stats.h"
 
 namespace dbengine {
-    using page_id_t = int32_t;
 
     /**
     * BufferPoolManager manages the in-memory buffer pool of pages 
@@ -19,29 +29,100 @@ namespace dbengine {
     * - Evict pages from memory when buffer is full
     * - Track which apges are pinned (in use)
     * - Write dirty pages back to disk
+    *
+    * If the DiskManager was opened with read_only_mmap, FetchPage returns pages
+    * directly from the file mapping: no frames, pinning or eviction are involved,
+    * and the returned pages must not be modified. Each mapped page's checksum is
+    * verified the first time it is handed out.
+    *
+    * Read-ahead: after READ_AHEAD_TRIGGER consecutive fetches of ascending page
+    * ids (or a HintSequential call), the next read-ahead window of pages is read
+    * asynchronously into unpinned frames. A fetch of a page still in flight
+    * waits for its read; unused read-ahead pages are evicted like any other.
+    *
+    * Concurrency: every method may be called from any thread. The page table is
+    * split into NUM_PAGE_TABLE_SHARDS flat PageTables with one writer latch each,
+    * pin counts and dirty flags are atomic, and a page read on a miss happens
+    * after the shard latch is released: the frame is published as loading, and
+    * concurrent fetches of the same page wait on that frame alone. A hit on a
+    * loaded page takes no latch at all: one probe of the page table, a pin by
+    * compare-and-swap, and a check that the frame still holds the page.
+    *
+    * Page contents are protected by a reader-writer latch per frame, taken by
+    * FetchPageRead/FetchPageWrite and held by the guard they return. FetchPage
+    * pins without latching; such callers coordinate among themselves. Flushes
+    * copy a page under its shared latch, so they never write a page a write
+    * guard is halfway through changing, and mark it clean before writing the
+    * copy: a change made during the write dirties the page again. A flush thus
+    * waits for the write guards on its pages; don't flush while holding one.
+    *
+    * A background writer thread keeps the frames next in line for eviction clean:
+    * every BG_WRITER_INTERVAL_MS it writes the dirty pages among the first
+    * BG_WRITER_CLEAN_TARGET of the evictable frames (in the replacer's eviction
+    * order), up to a rate limit. A miss then normally evicts a clean frame and
+    * only reads; eviction writes synchronously only when the writer fell behind.
+    *
+    * Frames come in chunks of up to FRAME_CHUNK_SIZE, one aligned FrameArena
+    * each, and the pool can be resized while in use (see Resize). Frame ids stay
+    * dense: a shrink takes the highest frames out of service and releases a chunk
+    * once none of its frames holds a page.
     */
 
-    class BufferPoolManager {
+    class BufferPoolManager : public BufferPool {
+        friend class ParallelBufferPoolManager;
+
         public:
         /**
         * Creates a new BufferPoolManager.
         * @param pool_size the size of the bufferv pool
         * @param disk_manager the disk manager 
+        * @param use_huge_pages back the frame arena with 2MB huge pages when available
+        * @param replacer_type page replacement policy
         */
 
-        BufferPoolManager(size_t pool_size, DiskManager *disk_manager);
+        BufferPoolManager(size_t pool_size, DiskManager *disk_manager, bool use_huge_pages = false,
+                          ReplacerType replacer_type = ReplacerType::LRU);
 
         /**
         * Destroys the buffer pool manager and flushed all dirty pages.
         */
-        ~BufferPoolManager();
+        ~BufferPoolManager() override;
 
         /**
         * Fetch a page from the buffer pool.
         * @param page_id the id of the page to fetch
         * @return pointer to the page, or nullptr if cannot fetch 
+        * @throws std::runtime_error if the page read from disk fails its checksum
+        */
+        Page *FetchPage(page_id_t page_id) override;
+
+        /**
+        * Fetch a page and latch it for reading (shared with other readers).
+        * @param page_id the id of the page to fetch
+        * @return a guard holding the pin and the latch; invalid if the page cannot be fetched
+        * @throws std::runtime_error if the page read from disk fails its checksum
         */
-        Page *FetchPage(page_id_t page_id);
+        ReadPageGuard FetchPageRead(page_id_t page_id) override;
+
+        /**
+        * Fetch a page for a bulk read through a scan ring, and latch it for reading.
+        * A miss recycles the ring's oldest frame once the ring is full (see ScanRing).
+        * @param page_id the id of the page to fetch
+        * @param ring the scan's ring, from NewScanRing
+        * @return a guard holding the pin and the latch; invalid if the page cannot be fetched
+        * @throws std::runtime_error if the page read from disk fails its checksum
+        */
+        ReadPageGuard FetchPageRead(page_id_t page_id, ScanRing *ring) override;
+
+        std::unique_ptr<ScanRing> NewScanRing(size_t num_frames = ScanRing::DEFAULT_NUM_FRAMES) override;
+
+        /**
+        * Fetch a page and latch it for writing (exclusive).
+        * @param page_id the id of the page to fetch
+        * @return a guard holding the pin and the latch; invalid if the page cannot be fetched
+        * @throws std::runtime_error if the page read from disk fails its checksum
+        */
+        WritePageGuard FetchPageWrite(page_id_t page_id) override;
 
         /**
         * Unpin a page, indicating you're done using it.
@@ -49,62 +130,424 @@ namespace dbengine {
         * @param is_dirty whether the pages was modified
         * @return false if page not in buffer or not pinned 
         */
-        bool UnpinPage(page_id_t page_id, bool is_dirty);
+        bool UnpinPage(page_id_t page_id, bool is_dirty) override;
 
         /**
-        * Flush a page to disk (write if dirty)
+        * Flush a page to disk (write if dirty). A copy taken under the page's shared
+        * latch is stamped with the checksum and written.
         * @param page_id the id of the page
         * @return false is page not in buffer
         */
-        bool FlushPage(page_id_t page_id);
+        bool FlushPage(page_id_t page_id) override;
 
         /**
         * Create a new page in the buffer pool.
         * @param[out] page_id the id of the new page
         * @return pointer to the new page, or nullptr if all frames pinned 
         */
-        Page *NewPage(page_id_t * page_id);
+        Page *NewPage(page_id_t * page_id) override;
+
+        /**
+        * Create a new page taken from the caller's extent, so pages of one
+        * table or index stay physically contiguous.
+        * @param[out] page_id the id of the new page
+        * @param extent the caller's extent cursor
+        * @return pointer to the new page, or nullptr if all frames pinned
+        */
+        Page *NewPage(page_id_t *page_id, PageExtent *extent) override;
+
+        /**
+        * Create a new page, latched for writing and already marked dirty.
+        * @param[out] page_id the id of the new page
+        * @param extent the caller's extent cursor, or nullptr
+        * @return a guard on the new page; invalid if all frames are pinned
+        */
+        WritePageGuard NewPageGuarded(page_id_t *page_id, PageExtent *extent = nullptr) override;
+
+        /**
+        * Give the unused pages of the caller's extent back to the allocation bitmap.
+        * @param extent the caller's extent cursor, reset on return
+        */
+        void ReleaseExtent(PageExtent *extent) override;
 
         /**
         * Delete a page from the buffer pool and disk.
         * @param page_id the id of the page
         * @return fsle if page is pinned or doesn't exist 
         */
-        bool DeletePage(page_id_t page_id);
+        bool DeletePage(page_id_t page_id) override;
+
+        /**
+        * Flush all dirty pages (checkpoint).
+        * Dirty pages are copied under their shared latch, FLUSH_BATCH_PAGES at a
+        * time, and the copies written in page id order with adjacent pages merged
+        * into single vectored writes, followed by one durability barrier.
+        */
+        void FlushAllPages() override;
+
+        /**
+        * Start asynchronous reads of pages [page_id, page_id + num_pages) that are not
+        * resident, using free or evictable frames. Pages past the end of the file and
+        * pages that don't get a frame are skipped. Advisory: read errors are dropped
+        * here and surface on the FetchPage of that page.
+        * @return number of reads started
+        */
+        size_t Prefetch(page_id_t page_id, size_t num_pages) override;
+
+        /**
+        * Tell the buffer pool that a sequential scan starts at page_id, so read-ahead
+        * begins with the first fetch instead of after READ_AHEAD_TRIGGER fetches.
+        * A ring scan reads ahead into its ring, at most half of the ring ahead.
+        */
+        void HintSequential(page_id_t page_id, ScanRing *ring = nullptr) override;
+
+        /**
+        * Set how many pages ahead sequential read-ahead reads (0 disables it).
+        */
+        inline void SetReadAheadWindow(size_t num_pages) { read_ahead_window_ = num_pages; }
+
+        inline size_t GetReadAheadWindow() const { return read_ahead_window_; }
+
+        /**
+        * Set how many pages per second the background writer may write (0 pauses it).
+        */
+        inline void SetBackgroundWriterRate(size_t pages_per_second) { bg_writer_rate_ = pages_per_second; }
+
+        inline size_t GetBackgroundWriterRate() const { return bg_writer_rate_; }
+
+        /**
+        * @return a snapshot of the buffer pool counters (disk I/O is in DiskManager::GetStats)
+        */
+        BufferPoolStats GetStats() const override;
+
+        inline const char *GetReplacerName() const { return replacer_->GetName(); }
+
+        /**
+        * Resize the pool to new_size frames while it is in use.
+        *
+        * Growing first puts frames that are out of service back into service, then
+        * maps new chunks for the rest. Shrinking takes frames [new_size, pool size)
+        * out of service: no page is loaded into them any more, the unpinned ones are
+        * evicted right away (dirty pages are written first), and pinned ones are
+        * evicted by the background writer soon after their last unpin. A chunk's
+        * memory is released once none of its frames is in service.
+        * @param new_size number of frames
+        * @throws std::invalid_argument if new_size is 0 or more than MAX_POOL_FRAMES
+        */
+        void Resize(size_t new_size);
 
         /**
-        * Flush all dirty pages 
+        * Keep the pool warm across restarts. From now on FlushAllPages and the
+        * destructor save the resident page ids, most recently used first, to the
+        * warm-up list (<db_file>.warmup, see warmup_list.h). If a list was saved by an
+        * earlier run, its hottest pages (as many as there are free frames) are read back
+        * in the background, in page id order so the reads sweep the file, while the pool
+        * is already serving fetches. Does nothing on a read-only mapped file.
+        * @return number of pages queued for warm-up
         */
-        void FlushAllPages();
+        size_t EnableWarmup();
+
+        /**
+        * @return the ids of the resident pages, pinned ones first, then the others in
+        * reverse eviction order
+        */
+        std::vector<page_id_t> GetHotPages();
+
+        /**
+        * @return number of frames in service
+        */
+        inline size_t GetPoolSize() const override { return pool_size_; }
+
+        /**
+        * @return number of frames backed by memory; above GetPoolSize() until a shrink is done
+        */
+        inline size_t GetAllocatedFrames() const { return allocated_frames_; }
+
+        // Number of independently latched page table shards
+        static constexpr size_t NUM_PAGE_TABLE_SHARDS = 16;
+
+        // Consecutive ascending fetches that switch read-ahead on
+        static constexpr size_t READ_AHEAD_TRIGGER = 2;
+
+        // Read-ahead window for pools of at least 4x this size (smaller pools use a quarter of their frames)
+        static constexpr size_t DEFAULT_READ_AHEAD_WINDOW = 32;
+
+        // Share of the evictable frames, next in eviction order, the background writer keeps clean
+        static constexpr double BG_WRITER_CLEAN_TARGET = 0.25;
+
+        // Default background writer rate limit, in pages per second (16MB/s)
+        static constexpr size_t DEFAULT_BG_WRITER_RATE = 4096;
+
+        // Pause between background writer rounds
+        static constexpr size_t BG_WRITER_INTERVAL_MS = 10;
+
+        // Warm-up reads are submitted in batches of this many pages
+        static constexpr size_t WARMUP_BATCH_PAGES = 256;
 
         private:
-            // TODO: Add your data members here
+            // Instance of a ParallelBufferPoolManager: caches only the pages with
+            // page_id % num_partitions == partition_index
+            BufferPoolManager(size_t pool_size, DiskManager *disk_manager, bool use_huge_pages,
+                              ReplacerType replacer_type, size_t partition_index, size_t num_partitions);
+
+            // Lifecycle of a frame. LOADING frames are mapped but their read is still running.
+            // RETIRED frames are out of service after a shrink (see Resize).
+            enum class FrameState : uint8_t { FREE, LOADING, READY, FAILED, RETIRED };
+
+            // Asynchronous read of a group of frames (see Prefetch)
+            struct PendingRead {
+                std::mutex latch;  // Held from setup through submission, and while completing
+                bool completed = false;
+                std::shared_ptr<IOBatch> batch;  // nullptr if submission failed
+                std::vector<frame_id_t> frames;
+            };
+
+            // Pin count of a frame nobody may pin: free, or claimed for eviction
+            static constexpr int32_t FRAME_CLAIMED = -1;
+
+            // Bookkeeping of one frame. The mapping fields only change under the latch of
+            // the shard holding page_id, or while the frame is claimed. Pins are taken by
+            // compare-and-swap and never on a claimed frame, so claiming (0 -> FRAME_CLAIMED)
+            // is how eviction and deletion make sure no lock-free reader holds the frame.
+            struct FrameHeader {
+                std::atomic<int32_t> pin_count{FRAME_CLAIMED};
+                std::atomic<bool> is_dirty{false};
+                std::atomic<page_id_t> page_id{INVALID_PAGE_ID};
+                std::atomic<FrameState> state{FrameState::FREE};
+                std::shared_ptr<PendingRead> pending_read;  // Read in flight (nullptr if none)
+                std::mutex latch;  // Pairs with cv to wait for LOADING to end
+                std::condition_variable cv;
+                std::shared_mutex rwlatch;  // Page contents; held by page guards
+                std::atomic<bool> writing_back{false};  // Background writer is writing a copy of the page
+                Page *page = nullptr;  // The frame's memory, in its chunk (nullptr while the chunk is released)
+            };
+
+            // Frames [first_frame, first_frame + num_frames), allocated and released together
+            struct FrameChunk {
+                frame_id_t first_frame;
+                size_t num_frames;
+                std::unique_ptr<FrameArena> arena;  // nullptr once released
+            };
+
+            // Frame headers are allocated in blocks of this many, which are never moved or freed
+            static constexpr size_t FRAME_BLOCK_SIZE = 256;
+
+            // Dirty pages FlushAllPages copies and writes at a time (1MB of copies)
+            static constexpr size_t FLUSH_BATCH_PAGES = 256;
+
+            // Most frames in one chunk (4MB: two huge pages), the unit a shrink releases
+            static constexpr size_t FRAME_CHUNK_SIZE = 1024;
+
+            // One partition of the page table: page_id -> frame_id. The latch serializes writers.
+            struct PageTableShard {
+                std::mutex latch;
+                PageTable page_table;
+            };
+
+            // Frames [0, pool_size_) are in service; [pool_size_, num_frames_) are being
+            // drained or retired after a shrink
+            std::atomic<size_t> pool_size_;
+            std::atomic<size_t> num_frames_;
+            std::atomic<size_t> allocated_frames_;  // Frames whose chunk holds memory
 
-            // Number of frames in the buffer pool
-            size_t pool_size_;
+            // Chunks of frame memory in frame id order (guarded by resize_latch_)
+            std::vector<FrameChunk> chunks_;
+            bool use_huge_pages_;
+            std::mutex resize_latch_;  // Serializes Resize and the release of chunks
+            std::mutex flush_latch_;  // Serializes FlushPage and FlushAllPages, so no two flushes write a page out of order
 
-            // Array of buffer pool pages
-            Page *pages_;
+            // Per-frame pin count, dirty flag, page id and load state, MAX_POOL_FRAMES / FRAME_BLOCK_SIZE blocks
+            std::unique_ptr<std::unique_ptr<FrameHeader[]>[]> frame_blocks_;
+            size_t num_frame_blocks_;  // Blocks allocated so far (guarded by resize_latch_)
 
             // Pointer to the disk manager
             DiskManager *disk_manager_;
 
-            // Page table: maps page_id to frame_id
-            std::unordered_map<page_id_t, frame_id_t> page_table_;
+            // Read-only mapped file: one bit per page, set once its checksum has been verified
+            std::unique_ptr<std::atomic<uint64_t>[]> mapped_verified_;
 
-            // Replacer: Finds unpinned frames for eviction
-            LRUReplacer *replacer_;
+            // Share of the page ids this pool caches (see ParallelBufferPoolManager); 0 of 1 if standalone
+            size_t partition_index_;
+            size_t num_partitions_;
 
-            // List of free frames (no page loaded)
-            std::vector<size_t> pin_count_;
+            // Page table, sharded by page id
+            std::vector<PageTableShard> shards_;
 
-            // Dirty flag for each frame
-            std::vector<bool> is_dirty_;
+            // Replacer: Finds unpinned frames for eviction (internally latched)
+            std::unique_ptr<Replacer> replacer_;
 
             // List of free frames (no page loaded)
             std::list<frame_id_t> free_list_;
+            std::mutex free_list_latch_;
+
+            // Reads in flight, oldest first
+            std::list<std::shared_ptr<PendingRead>> pending_reads_;
+            std::mutex pending_latch_;
+
+            // Sequential access detection
+            std::atomic<size_t> read_ahead_window_;
+            std::mutex read_ahead_latch_;  // Guards the three fields below
+            page_id_t last_fetched_page_id_;
+            size_t sequential_run_;
+            page_id_t read_ahead_end_;  // First page id past what read-ahead has requested
+
+            // Background writer
+            std::thread bg_writer_;
+            std::mutex bg_writer_latch_;  // Guards the two flags below
+            std::condition_variable bg_writer_cv_;
+            bool bg_writer_stop_;
+            bool bg_writer_wake_;  // An eviction had to write: start the next round now
+            std::atomic<size_t> bg_writer_rate_;
+
+            // Warm-up (see EnableWarmup)
+            std::string warmup_file_;  // Empty unless enabled; a ParallelBufferPoolManager keeps its own
+            std::mutex warmup_latch_;  // Guards warmup_file_ and writing the list
+            std::thread warmup_thread_;
+            std::atomic<bool> warmup_stop_;
+
+            // Statistics (see BufferPoolStats)
+            enum Counter : size_t {
+                HITS, MISSES, PIN_WAITS, FRAME_WAITS, NO_FRAME, EVICTIONS, EVICTION_WRITES,
+                BACKGROUND_WRITES, FLUSH_WRITES, PAGES_CREATED, PAGES_DELETED, PREFETCHED,
+                RING_REUSES, NUM_COUNTERS
+            };
+            StripedCounters<NUM_COUNTERS> counters_;
+
+            // Helper: Header of a frame
+            inline FrameHeader &Frame(frame_id_t frame_id) {
+                size_t frame = static_cast<size_t>(frame_id);
+                return frame_blocks_[frame / FRAME_BLOCK_SIZE][frame % FRAME_BLOCK_SIZE];
+            }
+
+            // Helper: Page held in a frame
+            inline Page *FramePage(frame_id_t frame_id) { return Frame(frame_id).page; }
+
+            // Helper: Shard owning a page id
+            inline PageTableShard &ShardFor(page_id_t page_id) {
+                // Pages of one partition share page_id % num_partitions_: divide that out first
+                return shards_[static_cast<uint64_t>(page_id) / num_partitions_ % NUM_PAGE_TABLE_SHARDS];
+            }
+
+            // Helper: Whether a page belongs to this pool's partition
+            inline bool OwnsPage(page_id_t page_id) const {
+                return static_cast<uint64_t>(page_id) % num_partitions_ == partition_index_;
+            }
+
+            // Helper: Pin a loaded page without latching (false if absent, loading or contended)
+            bool TryPinResident(PageTableShard &shard, page_id_t page_id, frame_id_t *frame_id);
+
+            // Helper: Drop a pin taken by TryPinResident on a frame that turned out not to match
+            void ReleaseSpeculativePin(frame_id_t frame_id);
+
+            // Helper: Claim an unpinned frame (0 -> FRAME_CLAIMED) so no one can pin it
+            inline bool ClaimFrame(FrameHeader &frame) {
+                int32_t expected = 0;
+                return frame.pin_count.compare_exchange_strong(expected, FRAME_CLAIMED);
+            }
+
+            // Helper: Frame holding a page the caller has pinned (PageTable::NO_FRAME if absent)
+            frame_id_t LookupPinnedFrame(PageTableShard &shard, page_id_t page_id);
+
+            // Helper: Take a free frame or evict one; with may_wait, wait for reads in flight if nothing else is left
+            bool AcquireFrame(frame_id_t *frame_id, bool may_wait);
+
+            // Helper: Take a frame from the free list only (false if it is empty)
+            bool TakeFreeFrame(frame_id_t *frame_id);
+
+            // Helper: Take a frame for a ring scan's miss: recycle the ring's oldest frame, or
+            // (while the ring fills up, or if that frame is in use) take one as AcquireFrame does
+            bool AcquireRingFrame(ScanRing *ring, page_id_t page_id, frame_id_t *frame_id, bool may_wait);
+
+            // Helper: Start one asynchronous read of the listed pages that are ours and not resident.
+            // Frames come from the ring if given; else with may_evict, from the free list or the
+            // replacer, otherwise only from the free list.
+            size_t StartReads(const page_id_t *page_ids, size_t num_pages, bool may_evict, ScanRing *ring = nullptr);
+
+            // Helper: Prefetch, into a scan's ring if given
+            size_t PrefetchRange(page_id_t page_id, size_t num_pages, ScanRing *ring);
+
+            // Helper: Read pages back in the background, hottest first up to the free frames
+            size_t WarmUp(const std::vector<page_id_t> &page_ids);
+
+            // Warm-up thread: submit the reads batch by batch
+            void WarmupLoop(std::vector<page_id_t> page_ids);
+
+            // Helper: Stop and join the warm-up thread
+            void StopWarmup();
+
+            // Helper: Save the warm-up list if enabled
+            void SaveWarmupList();
+
+            // Helper: Evict the page in a frame taken from the replacer (false if the frame changed hands meanwhile)
+            bool EvictFrame(frame_id_t frame_id);
+
+            // Helper: Reset a frame and put it on the free list (or retire it if out of service)
+            void ReturnFrame(frame_id_t frame_id);
+
+            // Helper: FetchPage, also reporting the frame (PageTable::NO_FRAME for mapped pages)
+            Page *FetchFrame(page_id_t page_id, frame_id_t *frame_id, ScanRing *ring = nullptr);
+
+            // Helper: Bring frames [pool_size_, new_size) into service, mapping a chunk if needed.
+            // Call with resize_latch_ held.
+            void Grow(size_t new_size);
+
+            // Helper: Map a chunk for frames [num_frames_, num_frames_ + num_frames), retired.
+            // Call with resize_latch_ held.
+            void AddChunk(size_t num_frames);
+
+            // Helper: Evict the unpinned frames out of service, then release chunks left with no
+            // frame in use. Call with resize_latch_ held.
+            void DrainFrames();
+
+            // Helper: Map a freshly allocated page id into an acquired frame and pin it
+            Page *InstallNewPage(frame_id_t frame_id, page_id_t new_page_id);
+
+            // Helper: Create a page whose id the caller already allocated (nullptr if all frames pinned)
+            Page *NewPageWithId(page_id_t page_id);
+
+            // Helper: Latch a page just created and hand it out as a dirty write guard
+            WritePageGuard GuardNewPage(page_id_t page_id, Page *page);
+
+            // Helper: Drop a page's unpinned frame, waiting out its read if one is in flight (false if pinned)
+            bool DiscardPage(page_id_t page_id);
+
+            // Helper: Wait until a frame is no longer LOADING
+            void WaitForFrame(frame_id_t frame_id);
+
+            // Helper: Publish a loaded frame and wake its waiters
+            void FinishLoad(frame_id_t frame_id);
+
+            // Helper: Unmap a frame whose read failed and wake its waiters
+            void FailLoad(frame_id_t frame_id);
+
+            // Helper: Drop a pin on a frame whose load failed; the last pin frees the frame
+            void ReleaseFailedPin(frame_id_t frame_id);
+
+            // Helper: Wait for a read in flight and publish (or drop) its frames
+            void CompleteRead(const std::shared_ptr<PendingRead> &read);
+
+            // Helper: Complete finished reads; with wait, complete every read in flight
+            void ReapReads(bool wait);
+
+            // Helper: Track sequential fetches and issue read-ahead
+            void NoteFetch(page_id_t page_id, ScanRing *ring = nullptr);
+
+            // Background writer thread: clean the frames next in line for eviction
+            void BackgroundWriterLoop();
+
+            // Helper: Write a copy of a dirty, unpinned frame's page without holding it (false if skipped)
+            bool CleanFrame(frame_id_t frame_id, char *buffer);
+
+            // Helper: Wait until the background writer is done with a frame. Call with its shard latched or the frame pinned.
+            void WaitForWriteBack(FrameHeader &frame);
+
+            // Helper: Copy a pinned frame's page under its shared latch and mark it clean (false if it was clean)
+            bool CopyDirtyPage(frame_id_t frame_id, char *buffer);
+
+            // Helper: Pin a frame for a flush. Call with its shard latched.
+            void PinForFlush(frame_id_t frame_id);
 
-            // Helper: Find a free frame or evict one
-            bool FindVictimFrame(frame_id_t * frame_id);
+            // Helper: Drop a pin taken by PinForFlush
+            void UnpinAfterFlush(frame_id_t frame_id);
     };
-}
\ No newline at end of file
+}
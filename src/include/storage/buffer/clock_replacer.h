@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include "storage/buffer/replacer.h"
+
+namespace dbengine {
+
+    /**
+    * ClockReplacer implements the CLOCK (second chance) replacement policy.
+    *
+    * Each frame has an atomic reference bit and an atomic evictable flag, so
+    * RecordAccess, Pin and Unpin are a single atomic store and never latch or
+    * move list nodes. Victim sweeps a hand over the frames under a latch:
+    * referenced frames get their bit cleared and are passed over once, and the
+    * first evictable frame found unreferenced is the victim.
+    *
+    * The per-frame flags live in fixed blocks that are only ever added, so the
+    * frame count can grow (SetNumFrames) under concurrent lock-free calls.
+    */
+    class ClockReplacer : public Replacer {
+        public:
+        /**
+        * Create a new ClockReplacer
+        * @param num_frames the number of frames in the buffer pool
+        */
+        explicit ClockReplacer(size_t num_frames);
+
+        ~ClockReplacer() override = default;
+
+        bool Victim(frame_id_t *frame_id) override;
+        size_t NextVictims(frame_id_t *frame_ids, size_t max_frames) override;
+        void Pin(frame_id_t frame_id) override;
+        void Unpin(frame_id_t frame_id) override;
+        void RecordAccess(frame_id_t frame_id, page_id_t page_id) override;
+        void Remove(frame_id_t frame_id) override;
+        size_t Size() override;
+        void SetNumFrames(size_t num_frames) override;
+
+        const char *GetName() const override { return "CLOCK"; }
+
+        private:
+        static constexpr size_t SLOT_BLOCK_SIZE = 1024;
+
+        struct Slot {
+            std::atomic<bool> referenced{false};
+            std::atomic<bool> evictable{false};
+        };
+
+        inline Slot &SlotOf(size_t frame) { return blocks_[frame / SLOT_BLOCK_SIZE][frame % SLOT_BLOCK_SIZE]; }
+
+        // Helper: Allocate the blocks covering frames [0, num_frames). Call with latch_ held.
+        void AddBlocks(size_t num_frames);
+
+        size_t num_frames_;         // Frames the hand sweeps (guarded by latch_)
+        std::unique_ptr<std::unique_ptr<Slot[]>[]> blocks_;  // MAX_POOL_FRAMES / SLOT_BLOCK_SIZE entries
+        size_t num_blocks_;         // Blocks allocated so far (guarded by latch_)
+        std::atomic<size_t> size_;  // Number of evictable frames
+        size_t hand_;               // Next frame the sweep looks at
+        std::mutex latch_;          // Serializes sweeps (guards hand_)
+    };
+} // namespace dbengine
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include "storage/page/page.h"
+
+namespace dbengine {
+
+    /**
+    * FrameArena is one contiguous, aligned allocation holding every buffer pool frame.
+    *
+    * Frames start on PAGE_SIZE boundaries, which O_DIRECT I/O requires. When huge
+    * pages are requested the arena is aligned to 2MB and advised for transparent
+    * huge pages, cutting TLB misses on large pools.
+    */
+    class FrameArena {
+        public:
+        /**
+        * @param num_frames number of frames to allocate
+        * @param use_huge_pages back the arena with 2MB pages when the OS allows it
+        */
+        FrameArena(size_t num_frames, bool use_huge_pages);
+
+        ~FrameArena();
+
+        FrameArena(const FrameArena &) = delete;
+        FrameArena &operator=(const FrameArena &) = delete;
+
+        inline Page *GetFrames() { return frames_; }
+
+        inline size_t GetNumFrames() const { return num_frames_; }
+
+        /**
+        * @return true if the arena was advised for (or allocated from) huge pages
+        */
+        inline bool IsHugePageBacked() const { return huge_pages_; }
+
+        // Huge page size on x86-64 and most aarch64 configurations
+        static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+        private:
+        void *base_;
+        size_t mapped_size_;
+        Page *frames_;
+        size_t num_frames_;
+        bool huge_pages_;
+    };
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+#include "storage/buffer/replacer.h"
+
+namespace dbengine {
+
+    /**
+    * LRUKReplacer implements the LRU-K replacement policy.
+    *
+    * The victim is the evictable frame whose K-th most recent access lies furthest
+    * in the past (largest backward K-distance). Frames with fewer than K recorded
+    * accesses have infinite distance and go first, oldest first access first, so
+    * a page read once by a scan loses to any page that was used twice. Accesses
+    * are counted by RecordAccess on a logical clock; a frame loaded by read-ahead
+    * and never fetched has no history at all and is evicted before anything else.
+    * Evictable frames are kept ordered by that key, so Victim is O(log n).
+    */
+    class LRUKReplacer : public Replacer {
+        public:
+        /**
+        * Create a new LRUKReplacer
+        * @param num_frames the number of frames in the buffer pool
+        * @param k how many past accesses decide a frame's distance
+        */
+        explicit LRUKReplacer(size_t num_frames, size_t k = 2);
+
+        ~LRUKReplacer() override = default;
+
+        bool Victim(frame_id_t *frame_id) override;
+        size_t NextVictims(frame_id_t *frame_ids, size_t max_frames) override;
+        void Pin(frame_id_t frame_id) override;
+        void Unpin(frame_id_t frame_id) override;
+        void RecordAccess(frame_id_t frame_id, page_id_t page_id) override;
+        void Remove(frame_id_t frame_id) override;
+        size_t Size() override;
+        void SetNumFrames(size_t num_frames) override;
+
+        const char *GetName() const override { return "LRU-K"; }
+
+        private:
+        struct FrameHistory {
+            std::deque<uint64_t> accesses;  // Up to k_ most recent access times, oldest first
+            page_id_t page_id = INVALID_PAGE_ID;
+            bool evictable = false;
+        };
+
+        // Ordering key: (has k accesses, oldest remembered access time), smallest evicted first
+        using EvictionKey = std::pair<std::pair<bool, uint64_t>, frame_id_t>;
+
+        EvictionKey KeyOf(frame_id_t frame_id) const;
+        void Reset(frame_id_t frame_id);
+
+        size_t k_;
+        std::vector<FrameHistory> frames_;
+        std::set<EvictionKey> evictable_;  // Evictable frames in eviction order
+        uint64_t current_time_;  // Logical clock, one tick per access
+        std::mutex latch_;
+    };
+} // namespace dbengine
@@ -1,19 +1,22 @@
 #pragma once
 
 #include <list>
+#include <mutex>
 #include <unordered_map>
 #include <cstdint>
+#include <cstddef>
+#include "storage/buffer/replacer.h"
 
 namespace dbengine {
-    using frame_id_t = int32_t; // Type alias for frame IDs
 
     /**
     * LRUReplacer implements the Least Recently Used replacement policy
     *
     * The replacer tracks UNPINNSED frames and evicts the least recently used one.
     * When a frame is pinned (being used), it's removed from the replacer. 
+    * All operations are serialized by an internal latch.
     */
-    class LRUReplacer {
+    class LRUReplacer : public Replacer {
         public:
         /**
         * Create a new LRUReplacer
@@ -24,33 +27,42 @@ namespace dbengine {
         /** 
         * Destroys the LRUReplacer
         */
-        ~LRUReplacer() = default;
+        ~LRUReplacer() override = default;
 
         /**
         * Remove the least recently used frame.
         * @param[out] frame_id the ID of the frame that was removed
         * @return true if a frame was removed, false if no frames were available
          */
-        bool Victim(frame_id_t *frame_id);
+        bool Victim(frame_id_t *frame_id) override;
+
+        /**
+        * List unpinned frames from least to most recently used.
+        */
+        size_t NextVictims(frame_id_t *frame_ids, size_t max_frames) override;
 
         /**
         * Pin a frame, indicating it's being used and should not be evicted.
         * Removes the frame from the replacer.
         * @param frame_id the ID of the frame to pin
          */
-        void Pin(frame_id_t frame_id);
+        void Pin(frame_id_t frame_id) override;
         
         /** 
         * Unpin a frame, making it available fro eviction.
         * Adds the frame to the replacer as most recetnly used.
         * @param frame_id the frame to unpin 
         */
-        void Unpin(frame_id_t frame_id);
+        void Unpin(frame_id_t frame_id) override;
 
         /**
         * @return the number of frames that are currently unpinned (evictable) 
         */
-        size_t Size();
+        size_t Size() override;
+
+        void SetNumFrames(size_t num_frames) override;
+
+        const char *GetName() const override { return "LRU"; }
 
         private:
         // TODO: Add your data members here
@@ -58,5 +70,6 @@ namespace dbengine {
         std::list<frame_id_t> lru_list_;
         std::unordered_map<frame_id_t, std::list<frame_id_t>::iterator> lru_map_;
         size_t max_size_;
+        std::mutex latch_;
     };
     } // namespace dbengine
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <shared_mutex>
+#include "common/config.h"
+#include "storage/page/page.h"
+
+namespace dbengine {
+
+    class BufferPoolManager;
+
+    /**
+    * ReadPageGuard holds a pin and a shared latch on one buffer pool page.
+    *
+    * Returned by BufferPoolManager::FetchPageRead. Any number of read guards on a
+    * page may be held at once; a write guard on it waits for all of them. The
+    * latch is released and the page unpinned when the guard is destroyed or
+    * dropped. Guards are move-only; a default-constructed or moved-from guard is
+    * invalid and releases nothing.
+    *
+    * Latches are not reentrant: a thread must not fetch a page it already guards.
+    */
+    class ReadPageGuard {
+        friend class BufferPoolManager;
+
+        public:
+        ReadPageGuard() = default;
+
+        ReadPageGuard(ReadPageGuard &&other) noexcept;
+        ReadPageGuard &operator=(ReadPageGuard &&other) noexcept;
+
+        ReadPageGuard(const ReadPageGuard &) = delete;
+        ReadPageGuard &operator=(const ReadPageGuard &) = delete;
+
+        ~ReadPageGuard() { Drop(); }
+
+        /**
+        * Release the latch and the pin now. The guard becomes invalid.
+        */
+        void Drop();
+
+        /**
+        * @return false if the fetch failed (or the guard was dropped or moved from)
+        */
+        inline bool IsValid() const { return page_ != nullptr; }
+
+        inline page_id_t GetPageId() const { return page_id_; }
+
+        inline const Page *GetPage() const { return page_; }
+
+        inline const char *GetData() const { return page_->GetData(); }
+
+        private:
+        // Takes over a pin and a shared latch already held (latch is nullptr for mapped pages)
+        ReadPageGuard(BufferPoolManager *bpm, page_id_t page_id, Page *page, std::shared_mutex *latch)
+            : bpm_(bpm), page_id_(page_id), page_(page), latch_(latch) {}
+
+        BufferPoolManager *bpm_ = nullptr;
+        page_id_t page_id_ = INVALID_PAGE_ID;
+        Page *page_ = nullptr;
+        std::shared_mutex *latch_ = nullptr;
+    };
+
+    /**
+    * WritePageGuard holds a pin and the exclusive latch on one buffer pool page.
+    *
+    * Returned by BufferPoolManager::FetchPageWrite and NewPageGuarded. Dirtiness is
+    * tracked by the guard: taking mutable access to the page (GetPageMut,
+    * GetDataMut) marks it dirty, and the page is unpinned as dirty on release.
+    */
+    class WritePageGuard {
+        friend class BufferPoolManager;
+
+        public:
+        WritePageGuard() = default;
+
+        WritePageGuard(WritePageGuard &&other) noexcept;
+        WritePageGuard &operator=(WritePageGuard &&other) noexcept;
+
+        WritePageGuard(const WritePageGuard &) = delete;
+        WritePageGuard &operator=(const WritePageGuard &) = delete;
+
+        ~WritePageGuard() { Drop(); }
+
+        /**
+        * Release the latch and the pin now, marking the page dirty if it was written.
+        */
+        void Drop();
+
+        inline bool IsValid() const { return page_ != nullptr; }
+
+        inline page_id_t GetPageId() const { return page_id_; }
+
+        inline const Page *GetPage() const { return page_; }
+
+        inline const char *GetData() const { return page_->GetData(); }
+
+        inline Page *GetPageMut() {
+            is_dirty_ = true;
+            return page_;
+        }
+
+        inline char *GetDataMut() { return GetPageMut()->GetData(); }
+
+        inline bool IsDirty() const { return is_dirty_; }
+
+        private:
+        // Takes over a pin and the exclusive latch already held
+        WritePageGuard(BufferPoolManager *bpm, page_id_t page_id, Page *page, std::shared_mutex *latch, bool is_dirty)
+            : bpm_(bpm), page_id_(page_id), page_(page), latch_(latch), is_dirty_(is_dirty) {}
+
+        BufferPoolManager *bpm_ = nullptr;
+        page_id_t page_id_ = INVALID_PAGE_ID;
+        Page *page_ = nullptr;
+        std::shared_mutex *latch_ = nullptr;
+        bool is_dirty_ = false;
+    };
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "common/config.h"
+#include "storage/buffer/replacer.h"
+
+namespace dbengine {
+
+    /**
+    * PageTable is a flat, open-addressed map from page id to frame id.
+    *
+    * Entries live inline in one array of slots (linear probing, load factor at
+    * most 1/2), so a lookup is one hash and usually one cache line, with no node
+    * to chase. Erase shifts the following entries back instead of leaving
+    * tombstones, so probe runs never degrade under eviction churn.
+    *
+    * Writers (Insert, Erase, Reserve) must be serialized by the caller. Find may
+    * run concurrently with a writer without any latch, with two caveats: the
+    * frame it returns may already belong to another page (callers check the
+    * frame's page id after pinning it), and it may miss an entry that a
+    * concurrent Erase is shifting. Callers that need a definite answer repeat
+    * the lookup while holding their writer latch.
+    */
+    class PageTable {
+        public:
+        static constexpr frame_id_t NO_FRAME = -1;
+
+        PageTable();
+
+        PageTable(const PageTable &) = delete;
+        PageTable &operator=(const PageTable &) = delete;
+
+        /**
+        * Grow the table so it holds num_entries without resizing. Writer only.
+        */
+        void Reserve(size_t num_entries);
+
+        /**
+        * Look up a page. Safe against one concurrent writer (see class comment).
+        * @return the frame holding page_id, or NO_FRAME
+        */
+        frame_id_t Find(page_id_t page_id) const;
+
+        /**
+        * Map page_id to frame_id unless page_id is already mapped. Writer only.
+        * @return false if page_id was already present (the table is unchanged)
+        */
+        bool Insert(page_id_t page_id, frame_id_t frame_id);
+
+        /**
+        * Remove page_id. Writer only.
+        * @return false if page_id was not present
+        */
+        bool Erase(page_id_t page_id);
+
+        inline size_t Size() const { return size_; }
+
+        private:
+        struct Slot {
+            std::atomic<page_id_t> page_id{INVALID_PAGE_ID};  // INVALID_PAGE_ID if empty
+            std::atomic<frame_id_t> frame_id{NO_FRAME};
+        };
+
+        struct SlotArray {
+            explicit SlotArray(size_t capacity) : slots(new Slot[capacity]), mask(capacity - 1) {}
+            std::unique_ptr<Slot[]> slots;
+            size_t mask;  // Capacity - 1 (capacity is a power of two)
+        };
+
+        inline static size_t Home(page_id_t page_id, size_t mask) {
+            // Fibonacci hashing: sequential (and strided) page ids spread over the whole table
+            return static_cast<size_t>((static_cast<uint64_t>(page_id) * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+        }
+
+        void Rehash(size_t capacity);
+
+        std::atomic<SlotArray *> current_;
+        // Every array ever published. Readers may still be probing an old one after a
+        // rehash, so they are kept until the table is destroyed; growth is geometric,
+        // so together they never exceed the current array.
+        std::vector<std::unique_ptr<SlotArray>> arrays_;
+        size_t size_;
+    };
+
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "storage/buffer/buffer_pool.h"
+#include "storage/buffer/buffer_pool_manager.h"
+#include "common/config.h"
+
+namespace dbengine {
+
+    /**
+    * ParallelBufferPoolManager spreads the page cache over several independent
+    * BufferPoolManager instances, each with its own frames, replacer, free list,
+    * page table and background writer, so threads working on different pages
+    * rarely touch the same shared structure.
+    *
+    * Pages are partitioned by id: page p lives in instance p % num_instances.
+    * Consecutive page ids land on consecutive instances, so a table or index
+    * spreads over all of them, and a sequential scan reads ahead in every
+    * instance at once (each one reads its own share of the window).
+    *
+    * New page ids come from the DiskManager as usual and the page is created in
+    * the instance owning the id; since the allocator hands out ids in sequence,
+    * new pages go round-robin over the instances. NewPage fails if the owning
+    * instance has all of its frames pinned, even if others have room.
+    */
+    class ParallelBufferPoolManager : public BufferPool {
+        public:
+        /**
+        * Creates the instances.
+        * @param num_instances number of BufferPoolManager instances
+        * @param pool_size frames per instance
+        * @param disk_manager the disk manager, shared by all instances
+        * @param use_huge_pages back each instance's frame arena with 2MB huge pages when available
+        * @param replacer_type page replacement policy of every instance
+        */
+        ParallelBufferPoolManager(size_t num_instances, size_t pool_size, DiskManager *disk_manager,
+                                  bool use_huge_pages = false, ReplacerType replacer_type = ReplacerType::LRU);
+
+        /**
+        * Destroys the instances, flushing all dirty pages.
+        */
+        ~ParallelBufferPoolManager() override;
+
+        Page *FetchPage(page_id_t page_id) override;
+
+        ReadPageGuard FetchPageRead(page_id_t page_id) override;
+
+        ReadPageGuard FetchPageRead(page_id_t page_id, ScanRing *ring) override;
+
+        /**
+        * The ring is split over the instances: each one recycles frames of its own part.
+        */
+        std::unique_ptr<ScanRing> NewScanRing(size_t num_frames = ScanRing::DEFAULT_NUM_FRAMES) override;
+
+        WritePageGuard FetchPageWrite(page_id_t page_id) override;
+
+        bool UnpinPage(page_id_t page_id, bool is_dirty) override;
+
+        bool FlushPage(page_id_t page_id) override;
+
+        Page *NewPage(page_id_t *page_id) override;
+
+        Page *NewPage(page_id_t *page_id, PageExtent *extent) override;
+
+        WritePageGuard NewPageGuarded(page_id_t *page_id, PageExtent *extent = nullptr) override;
+
+        void ReleaseExtent(PageExtent *extent) override;
+
+        bool DeletePage(page_id_t page_id) override;
+
+        /**
+        * Flush the dirty pages of every instance, and save the warm-up list if enabled.
+        */
+        void FlushAllPages() override;
+
+        /**
+        * Each instance prefetches the pages of the range it owns.
+        * @return number of reads started over all instances
+        */
+        size_t Prefetch(page_id_t page_id, size_t num_pages) override;
+
+        void HintSequential(page_id_t page_id, ScanRing *ring = nullptr) override;
+
+        /**
+        * @return the counters of all instances added up
+        */
+        BufferPoolStats GetStats() const override;
+
+        /**
+        * Set the read-ahead window of a scan, in pages; each instance reads its share.
+        */
+        void SetReadAheadWindow(size_t num_pages);
+
+        /**
+        * Set the background writer rate of each instance, in pages per second.
+        */
+        void SetBackgroundWriterRate(size_t pages_per_second);
+
+        /**
+        * Resize every instance while the pool is in use (see BufferPoolManager::Resize).
+        * @param pool_size frames per instance
+        */
+        void Resize(size_t pool_size);
+
+        /**
+        * Keep the pool warm across restarts (see BufferPoolManager::EnableWarmup).
+        * The list is shared by all instances, so it still applies after a restart
+        * with a different number of instances.
+        * @return number of pages queued for warm-up over all instances
+        */
+        size_t EnableWarmup();
+
+        /**
+        * @return the resident page ids of all instances, interleaving their hottest first
+        */
+        std::vector<page_id_t> GetHotPages();
+
+        inline size_t GetNumInstances() const { return instances_.size(); }
+
+        /**
+        * @return total number of frames over all instances
+        */
+        inline size_t GetPoolSize() const override { return pool_size_ * instances_.size(); }
+
+        /**
+        * @return the instance caching a page
+        */
+        inline BufferPoolManager *GetInstance(page_id_t page_id) const {
+            return instances_[static_cast<uint64_t>(page_id) % instances_.size()].get();
+        }
+
+        private:
+            // Frames per instance
+            size_t pool_size_;
+
+            // Shared by the instances; new page ids are allocated here
+            DiskManager *disk_manager_;
+
+            std::vector<std::unique_ptr<BufferPoolManager>> instances_;
+
+            // Warm-up list of the whole pool; empty unless enabled
+            std::string warmup_file_;
+            std::mutex warmup_latch_;
+
+            // Helper: Save the warm-up list if enabled
+            void SaveWarmupList();
+    };
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "common/config.h"
+
+namespace dbengine {
+    using frame_id_t = int32_t; // Type alias for frame IDs
+
+    enum class ReplacerType {
+        LRU,      // Least recently unpinned frame
+        CLOCK,    // Second chance: reference bits swept by a clock hand
+        LRU_K,    // Largest backward K-distance (K = 2)
+        TWO_Q     // Scan resistant: pages touched once age out before re-referenced ones
+    };
+
+    /**
+    * Replacer picks the frame to evict among the frames it tracks.
+    *
+    * The buffer pool calls Unpin when a frame's pin count drops to zero (the frame
+    * becomes evictable) and Pin when it rises from zero. RecordAccess is called on
+    * every fetch of a page, hit or miss, so policies that weigh access history
+    * (CLOCK, LRU-K, 2Q) see repeated use of pinned pages too. A frame returned by
+    * Victim, or dropped with Remove, starts over with no history.
+    *
+    * Implementations are safe to call from several threads at once.
+    */
+    class Replacer {
+        public:
+        virtual ~Replacer() = default;
+
+        /**
+        * Remove the frame the policy would evict next.
+        * @param[out] frame_id the ID of the frame that was removed
+        * @return true if a frame was removed, false if no frames were available
+        */
+        virtual bool Victim(frame_id_t *frame_id) = 0;
+
+        /**
+        * List the frames Victim would pick next, in order, without removing them or
+        * aging anything. Used to clean frames ahead of their eviction.
+        * @param[out] frame_ids receives up to max_frames frame ids
+        * @return number of frames listed
+        */
+        virtual size_t NextVictims(frame_id_t *frame_ids, size_t max_frames) = 0;
+
+        /**
+        * Pin a frame: it stays tracked but cannot be evicted.
+        * @param frame_id the ID of the frame to pin
+        */
+        virtual void Pin(frame_id_t frame_id) = 0;
+
+        /**
+        * Unpin a frame, making it available for eviction.
+        * @param frame_id the frame to unpin
+        */
+        virtual void Unpin(frame_id_t frame_id) = 0;
+
+        /**
+        * Record an access to the page held by a frame.
+        * @param frame_id the frame holding the page
+        * @param page_id the page accessed (a different page than before means the frame was reloaded)
+        */
+        virtual void RecordAccess(frame_id_t frame_id, page_id_t page_id) { (void)frame_id; (void)page_id; }
+
+        /**
+        * Forget a frame whose page left the pool without being chosen by Victim.
+        * @param frame_id the frame to drop
+        */
+        virtual void Remove(frame_id_t frame_id) { Pin(frame_id); }
+
+        /**
+        * @return the number of frames that are currently unpinned (evictable)
+        */
+        virtual size_t Size() = 0;
+
+        /**
+        * Track frames [0, num_frames) after the buffer pool was resized. Frames
+        * past the new end were Removed first, though a late Unpin may still name
+        * one (the buffer pool skips such a victim). Safe while the replacer is in use.
+        * @param num_frames the new number of frames (at most MAX_POOL_FRAMES)
+        */
+        virtual void SetNumFrames(size_t num_frames) = 0;
+
+        virtual const char *GetName() const = 0;
+
+        /**
+        * Create a replacer of the given type.
+        * @param type replacement policy
+        * @param num_frames the maximum number of frames the replacer can track
+        */
+        static std::unique_ptr<Replacer> Create(ReplacerType type, size_t num_frames);
+    };
+} // namespace dbengine
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "storage/buffer/replacer.h"
+
+namespace dbengine {
+
+    /**
+    * TwoQueueReplacer implements the full 2Q replacement policy.
+    *
+    * A page accessed for the first time enters A1in, a FIFO. Further accesses
+    * while it sits in A1in are treated as correlated (e.g. every tuple of one
+    * page) and don't promote it. When A1in holds more than a quarter of the
+    * frames it is drained first, and the ids of pages evicted from it are kept
+    * in A1out, a bounded ghost list. A page loaded again while its id is in
+    * A1out has proven reuse and goes to Am, an LRU list that only loses frames
+    * once A1in is small. A sequential scan therefore cycles through A1in
+    * without touching the working set in Am.
+    */
+    class TwoQueueReplacer : public Replacer {
+        public:
+        /**
+        * Create a new TwoQueueReplacer
+        * @param num_frames the number of frames in the buffer pool
+        */
+        explicit TwoQueueReplacer(size_t num_frames);
+
+        ~TwoQueueReplacer() override = default;
+
+        bool Victim(frame_id_t *frame_id) override;
+        size_t NextVictims(frame_id_t *frame_ids, size_t max_frames) override;
+        void Pin(frame_id_t frame_id) override;
+        void Unpin(frame_id_t frame_id) override;
+        void RecordAccess(frame_id_t frame_id, page_id_t page_id) override;
+        void Remove(frame_id_t frame_id) override;
+        size_t Size() override;
+        void SetNumFrames(size_t num_frames) override;
+
+        const char *GetName() const override { return "2Q"; }
+
+        private:
+        enum class Queue { NONE, A1IN, AM };
+
+        struct FrameEntry {
+            Queue queue = Queue::NONE;
+            std::list<frame_id_t>::iterator position;
+            page_id_t page_id = INVALID_PAGE_ID;
+            bool evictable = false;
+        };
+
+        // Helper: First evictable frame of a list, searched from its eviction end
+        bool FindEvictable(const std::list<frame_id_t> &queue, bool from_front, frame_id_t *frame_id) const;
+
+        // Helper: Take a frame off its list and forget it
+        void Detach(frame_id_t frame_id);
+
+        // Helper: Remember the id of a page evicted from A1in
+        void RememberGhost(page_id_t page_id);
+
+        std::vector<FrameEntry> frames_;
+        std::list<frame_id_t> a1in_;  // FIFO: oldest at the front
+        std::list<frame_id_t> am_;    // LRU: most recent at the front
+        std::list<page_id_t> a1out_;  // Ghost ids, oldest at the front
+        std::unordered_map<page_id_t, std::list<page_id_t>::iterator> a1out_map_;
+        size_t kin_;             // A1in share above which it is drained first
+        size_t a1out_capacity_;  // Ghost ids remembered
+        size_t size_;            // Number of evictable frames
+        std::mutex latch_;
+    };
+} // namespace dbengine
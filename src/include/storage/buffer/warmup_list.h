@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "common/config.h"
+
+namespace dbengine {
+
+    /**
+    * The warm-up list is a sidecar file (<db_file>.warmup) holding the page ids
+    * that were resident in the buffer pool at the last checkpoint or shutdown,
+    * most recently used first. On the next start the buffer pool reads those
+    * pages back in the background (see BufferPoolManager::EnableWarmup).
+    *
+    * The list is only a hint: it is replaced atomically (written to a temporary
+    * file, then renamed), and a missing, truncated or foreign file reads back as
+    * an empty list.
+    */
+
+    /**
+    * @return the sidecar file name for a database file
+    */
+    std::string WarmupFileName(const std::string &db_file);
+
+    /**
+    * Replace the warm-up list.
+    * @throws std::runtime_error if the file cannot be written
+    */
+    void WriteWarmupList(const std::string &file_name, const std::vector<page_id_t> &page_ids);
+
+    /**
+    * @return the saved page ids, hottest first; empty if there is no usable list
+    */
+    std::vector<page_id_t> ReadWarmupList(const std::string &file_name);
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dbengine {
+
+    /**
+    * Self-contained compressor producing the LZ4 block format
+    * (token, literals, 2-byte offset, match length; no frame header).
+    * Single-pass greedy matching with a small hash table: fast rather than dense.
+    */
+    class Lz4Codec {
+        public:
+        /**
+        * Compress `src` into `dst`.
+        * @return compressed size, or 0 if the output would not fit in dst_capacity
+        */
+        static size_t Compress(const char *src, size_t src_size, char *dst, size_t dst_capacity);
+
+        /**
+        * Decompress a block produced by Compress.
+        * @return decompressed size, or 0 if the block is malformed or does not fit in dst_capacity
+        */
+        static size_t Decompress(const char *src, size_t src_size, char *dst, size_t dst_capacity);
+
+        /**
+        * Worst-case compressed size for an input of src_size bytes.
+        */
+        static constexpr size_t MaxCompressedSize(size_t src_size) {
+            return src_size + src_size / 255 + 16;
+        }
+    };
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/config.h"
+
+namespace dbengine {
+
+    /**
+    * On-disk header of the allocation bitmap file.
+    * Page 0 of the file holds this header; bitmap pages follow it.
+    */
+    struct AllocationHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t num_bitmap_pages;
+        uint32_t reserved;
+        // Free count per bitmap page, so untouched bitmap pages never have to be read
+        uint32_t free_counts[(PAGE_SIZE - 4 * sizeof(uint32_t)) / sizeof(uint32_t)];
+    };
+
+    static_assert(sizeof(AllocationHeader) == PAGE_SIZE, "AllocationHeader must fill exactly one page");
+
+    /**
+    * AllocationBitmap persists which database pages are free for reuse.
+    *
+    * One bit per page (set = free), PAGE_SIZE * 8 pages per bitmap page. Bitmap
+    * pages are loaded lazily the first time they are needed.
+    *
+    * Crash safety: a page taken from the bitmap is cleared and synced to disk
+    * before it is handed out, so a crash (even power loss) can never hand the same
+    * page out twice. This costs one fdatasync per reuse of freed pages; pages
+    * appended to the file never touch the bitmap. Frees are written back on
+    * Flush(); a crash before that only leaks the page.
+    */
+    class AllocationBitmap {
+        public:
+        /**
+        * Open (or create) the bitmap file.
+        * @param file_name path of the bitmap file
+        * @param reset discard any existing contents (used when the database file is new)
+        */
+        AllocationBitmap(const std::string &file_name, bool reset);
+
+        ~AllocationBitmap();
+
+        /**
+        * Take the lowest-numbered free page.
+        * @return the page id, or INVALID_PAGE_ID if no page is free
+        */
+        page_id_t AllocateFreePage();
+
+        /**
+        * Take a run of contiguous free pages starting at the lowest-numbered free page.
+        * @param max_pages longest run to take
+        * @param[out] num_pages length of the run taken (0 if no page is free)
+        * @param boundary if nonzero, the run ends before crossing a multiple of this many pages
+        * @return the first page id of the run, or INVALID_PAGE_ID if no page is free
+        */
+        page_id_t AllocateFreeRun(uint32_t max_pages, uint32_t *num_pages, uint32_t boundary = 0);
+
+        /**
+        * Mark a page as free. Freeing a page that is already free is a no-op.
+        * @return false if the page id is beyond what the bitmap can track
+        */
+        bool MarkFree(page_id_t page_id);
+
+        /**
+        * @return true if the page is currently marked free
+        */
+        bool IsFree(page_id_t page_id);
+
+        /**
+        * Write back dirty bitmap pages and the header, then sync the file.
+        */
+        void Flush();
+
+        /**
+        * @return the number of free pages across all bitmap pages
+        */
+        uint64_t GetFreeCount() const;
+
+        // Pages covered by one bitmap page
+        static constexpr uint32_t PAGES_PER_BITMAP_PAGE = PAGE_SIZE * 8;
+
+        // Maximum number of bitmap pages the header can describe
+        static constexpr uint32_t MAX_BITMAP_PAGES = sizeof(AllocationHeader::free_counts) / sizeof(uint32_t);
+
+        // Pages past this id are never recorded as free (their space is leaked on deallocation)
+        static constexpr page_id_t MAX_TRACKED_PAGES = static_cast<page_id_t>(MAX_BITMAP_PAGES) * PAGES_PER_BITMAP_PAGE;
+
+        private:
+        struct BitmapPage {
+            std::unique_ptr<uint64_t[]> words;  // nullptr until loaded
+            bool dirty = false;
+        };
+
+        static constexpr uint32_t WORDS_PER_BITMAP_PAGE = PAGE_SIZE / sizeof(uint64_t);
+
+        uint64_t *LoadBitmapPage(uint32_t index);
+        void WriteBitmapPage(uint32_t index);
+        void WriteHeader();
+
+        int fd_;
+        std::string file_name_;
+        AllocationHeader header_;
+        bool header_dirty_;
+        std::vector<BitmapPage> bitmap_pages_;
+        uint32_t search_hint_;  // No bitmap page below this index has a free page
+    };
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/config.h"
+
+namespace dbengine {
+
+    /**
+    * Location of one page's compressed block in the data file.
+    */
+    struct PageMapEntry {
+        uint64_t sector;          // First sector of the block
+        uint32_t stored_size;     // Bytes last written to the block
+        uint16_t capacity;        // Sectors reserved for the block (0 = page never written)
+        uint16_t flags;           // PAGE_MAP_RAW if stored uncompressed
+    };
+
+    static_assert(sizeof(PageMapEntry) == 16, "PageMapEntry is written to disk as-is");
+
+    /**
+    * CompressedPageStore keeps pages LZ4-compressed in the data file.
+    *
+    * Compressed blocks are placed in SECTOR_SIZE units. The page map (page id ->
+    * block) lives in <db_file>.pagemap and is written back on Flush(). A rewritten
+    * page stays in place if it still fits its block; otherwise it moves to a new
+    * block. Compressed blocks carry their own length, so an in-place rewrite is
+    * readable through a map that was not flushed yet. Blocks released since the
+    * last Flush() are not reused until the map on disk stops pointing at them.
+    * Pages that don't compress to less than PAGE_SIZE - SECTOR_SIZE are stored raw.
+    */
+    class CompressedPageStore {
+        public:
+        /**
+        * @param data_fd open descriptor of the data file (not owned)
+        * @param map_file_name path of the page map file
+        * @param reset discard an existing page map (the data file is new)
+        */
+        CompressedPageStore(int data_fd, const std::string &map_file_name, bool reset);
+
+        ~CompressedPageStore();
+
+        /**
+        * Compress and write a page.
+        */
+        void WritePage(page_id_t page_id, const char *page_data);
+
+        /**
+        * Read and decompress a page. Pages never written read back as zeros.
+        */
+        void ReadPage(page_id_t page_id, char *page_data);
+
+        /**
+        * Release the block of a deallocated page.
+        */
+        void ReleasePage(page_id_t page_id);
+
+        /**
+        * Sync the data file, then write back the dirty parts of the page map.
+        */
+        void Flush();
+
+        /**
+        * @return number of page ids the map covers (the logical page count)
+        */
+        inline page_id_t GetNumPages() const { return static_cast<page_id_t>(entries_.size()); }
+
+        /**
+        * @return bytes of the data file in use by compressed blocks
+        */
+        uint64_t GetStoredBytes() const;
+
+        static constexpr uint32_t SECTOR_SIZE = 512;
+        static constexpr uint16_t PAGE_MAP_RAW = 1;
+
+        private:
+        static constexpr uint32_t MAX_SECTORS = PAGE_SIZE / SECTOR_SIZE;
+        static constexpr uint32_t ENTRIES_PER_MAP_PAGE = PAGE_SIZE / sizeof(PageMapEntry);
+
+        uint64_t AllocateBlock(uint16_t sectors);
+        void AddFreeSpace(uint64_t sector, uint64_t num_sectors);
+        void RebuildFreeSpace();
+        void WriteBlock(uint64_t sector, const char *data, size_t length);
+        void ReadBlock(uint64_t sector, char *data, size_t length);
+        void WriteMapChunk(size_t chunk);
+
+        int data_fd_;
+        int map_fd_;
+        std::string map_file_name_;
+        std::vector<PageMapEntry> entries_;
+        std::vector<bool> dirty_chunks_;  // Map chunks (ENTRIES_PER_MAP_PAGE entries) changed since Flush()
+        bool map_grew_;
+
+        // Free blocks by size in sectors (index 1..MAX_SECTORS)
+        std::vector<std::vector<uint64_t>> free_blocks_;
+        // Blocks released since the last Flush(): (sector, size)
+        std::vector<std::pair<uint64_t, uint16_t>> pending_free_;
+        uint64_t end_sector_;  // First sector past every block
+    };
+
+}
@@ -1,36 +1,286 @@
 #pragma once
 
+#include <atomic>
 #include <string>
-#include <fstream>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include "common/config.h"
+#include "common/stats.h"
+#include "storage/disk/allocation_bitmap.h"
+#include "storage/disk/compressed_page_store.h"
+#include "storage/disk/io_engine.h"
 
 namespace dbengine {
-    
+
+    /**
+    * One page worth of I/O in a batched ReadPages/WritePages call.
+    */
+    struct PageRequest {
+        page_id_t page_id;
+        char *data;
+    };
+
+    /**
+    * Cursor over the extent an owner (table heap, index) is currently filling.
+    * Pages handed out through the same PageExtent are physically contiguous
+    * within each extent, so scans over the owner read sequentially.
+    */
+    struct PageExtent {
+        page_id_t next_page_id = INVALID_PAGE_ID;
+        page_id_t end_page_id = INVALID_PAGE_ID;
+    };
+
+    struct DiskManagerOptions {
+        // I/O engine used by the batched APIs
+        IOEngineType io_engine = IOEngineType::AUTO;
+
+        // Bypass the kernel page cache (O_DIRECT) so the buffer pool is the only cache.
+        // Batched and coalesced I/O then require PAGE_SIZE-aligned buffers, such as
+        // buffer pool frames; single-page reads and writes accept any buffer.
+        bool direct_io = false;
+
+        // Open the file read-only and map it into memory. BufferPoolManager then hands
+        // out pages straight from the mapping, verifying each page's checksum the first
+        // time; writes and allocation are rejected.
+        bool read_only_mmap = false;
+
+        // Store pages LZ4-compressed in variable-size blocks, located through the
+        // <db_file>.pagemap sidecar. Frames in memory stay uncompressed. Batched APIs
+        // then run page by page. Cannot be combined with direct_io or read_only_mmap.
+        bool compression = false;
+
+        // Further data files of the tablespace, e.g. on other devices. Pages are striped
+        // over db_file and these files in TABLESPACE_STRIPE_PAGES units, and each file
+        // gets its own I/O engine so requests to different files proceed in parallel.
+        // Must be reopened with the same files in the same order. Cannot be combined
+        // with compression or read_only_mmap.
+        std::vector<std::string> tablespace_files;
+    };
+
+    /**
+    * DiskManager activity since the file was opened (see DiskManager::GetStats).
+    */
+    struct DiskStats {
+        uint64_t pages_read = 0;         // Every read path, batched ones included
+        uint64_t pages_written = 0;      // Every write path, batched and coalesced included
+        uint64_t pages_allocated = 0;    // Page ids handed out
+        uint64_t pages_reused = 0;       // ... of which came from the free page bitmap
+        uint64_t extents_allocated = 0;
+        uint64_t pages_deallocated = 0;
+        uint64_t syncs = 0;
+        HistogramSnapshot read_latency;   // Single-page ReadPage calls
+        HistogramSnapshot write_latency;  // Single-page WritePage calls
+
+        /**
+        * Multi-line text dump, one "name value" pair per line.
+        */
+        std::string ToString() const;
+    };
+
     class DiskManager {
-        public: 
+        public:
 
-        explicit DiskManager(const std::string &db_file);
+        /**
+        * Open (or create) the database file, plus any further tablespace files.
+        * @param db_file path of the (first) database file
+        * @param options I/O engine, caching and tablespace options
+        */
+        explicit DiskManager(const std::string &db_file, const DiskManagerOptions &options = DiskManagerOptions());
 
          ~DiskManager();
 
+         /**
+         * @throws std::out_of_range if the page id is negative
+         */
          void WritePage(page_id_t page_id, const char *page_data);
 
+         /**
+         * @throws std::out_of_range if the page id is negative or past the end of the file
+         */
          void ReadPage(page_id_t page_id, char *page_data);
 
+         /**
+         * Read many pages with all requests in flight at once. Blocks until every read completes.
+         * @throws std::out_of_range if any page id is past the end of the file
+         */
+         void ReadPages(const std::vector<PageRequest> &requests);
+
+         /**
+         * Write many pages with all requests in flight at once. Blocks until every write completes.
+         */
+         void WritePages(const std::vector<PageRequest> &requests);
+
+         /**
+         * Queue reads without waiting. The buffers must stay valid until WaitForBatch returns.
+         * Consecutive pages of one file whose buffers are also adjacent in memory are read
+         * with a single request (up to MAX_MERGED_PAGES).
+         * @return handle to pass to WaitForBatch
+         */
+         std::shared_ptr<IOBatch> SubmitReadPages(const std::vector<PageRequest> &requests);
+
+         /**
+         * Queue writes without waiting. The buffers must stay valid until WaitForBatch returns.
+         * @return handle to pass to WaitForBatch
+         */
+         std::shared_ptr<IOBatch> SubmitWritePages(const std::vector<PageRequest> &requests);
+
+         /**
+         * Block until a submitted batch finishes and check its results.
+         * @throws std::runtime_error if any request in the batch failed
+         */
+         void WaitForBatch(const std::shared_ptr<IOBatch> &batch);
+
+         /**
+         * Write pages sorted by page id, merging physically adjacent pages into single
+         * vectored writes. Does not sync; call Sync() for durability.
+         * @param requests pages to write, in any order (reordered in place)
+         */
+         void WritePagesCoalesced(std::vector<PageRequest> &requests);
+
+         /**
+         * Durability barrier: wait until all written pages and the allocation bitmap reach stable storage.
+         */
+         void Sync();
+
+         /**
+         * Allocate a page, reusing a freed page from the allocation bitmap when possible.
+         */
          page_id_t AllocatePage();
 
+         /**
+         * Allocate the next page of the owner's current extent. When the current one
+         * is used up, the extent is refilled with a run of up to EXTENT_SIZE freed
+         * pages from the allocation bitmap, or else a new EXTENT_SIZE extent is
+         * reserved at the end of the file.
+         * @param extent the owner's extent cursor
+         */
+         page_id_t AllocatePage(PageExtent *extent);
+
+         /**
+         * Return the pages of an extent that were never handed out to the allocation
+         * bitmap, when its owner goes away, and reset the cursor.
+         */
+         void ReleaseExtent(PageExtent *extent);
+
+         /**
+         * Reserve num_pages contiguous pages at the end of the file and preallocate
+         * their space (fallocate) so they are laid out contiguously on disk. In a
+         * multi-file tablespace the extent starts on a stripe boundary; pages skipped
+         * to get there are marked free for reuse.
+         * @return the first page id of the extent
+         */
+         page_id_t AllocateExtent(uint32_t num_pages);
+
+         /**
+         * Return a page to the allocation bitmap so a later AllocatePage can reuse it.
+         */
          void DeallocatePage(page_id_t page_id);
 
-         inline int32_t GetNumPages() const { return num_pages_; };
+         /**
+         * @return the number of pages currently free for reuse
+         */
+         uint64_t GetNumFreePages() const;
+
+         inline page_id_t GetNumPages() const { return num_pages_; };
+
+         inline const std::string &GetFileName() const { return file_name_; }
+
+         inline const char *GetIOEngineName() const { return files_[0].io_engine->GetName(); }
+
+         /**
+         * @return number of data files in the tablespace
+         */
+         inline size_t GetNumFiles() const { return files_.size(); }
+
+         /**
+         * @return index of the tablespace file that holds the page
+         */
+         inline size_t GetFileIndex(page_id_t page_id) const { return Locate(page_id).file; }
+
+         /**
+         * @return true if the file is mapped read-only (DiskManagerOptions::read_only_mmap)
+         */
+         inline bool IsReadOnlyMapped() const { return read_only_; }
+
+         /**
+         * Pointer to a page inside the read-only mapping. Valid until the DiskManager is destroyed.
+         * @throws std::out_of_range if the page is past the end of the file
+         * @throws std::logic_error if the file is not mapped
+         */
+         const char *GetMappedPage(page_id_t page_id) const;
+
+         /**
+         * @return true if the file is open with O_DIRECT (false if requested but unsupported by the filesystem)
+         */
+         inline bool IsDirectIO() const { return direct_io_; }
+
+         /**
+         * @return true if pages are stored compressed (DiskManagerOptions::compression)
+         */
+         inline bool IsCompressed() const { return compressed_store_ != nullptr; }
+
+         /**
+         * @return bytes of the database file holding page data (compressed size in compressed mode)
+         */
+         uint64_t GetStoredBytes() const;
+
+         /**
+         * @return a snapshot of the I/O and allocation counters and latency histograms
+         */
+         DiskStats GetStats() const;
+
+         // Most pages a single merged read request covers
+         static constexpr size_t MAX_MERGED_PAGES = 64;
 
          private:
-         std::fstream db_io_;  // Stream for database file
+         // One data file of the tablespace
+         struct DataFile {
+             int fd;
+             std::string name;
+             std::unique_ptr<IOEngine> io_engine;  // Per-file queue
+         };
+
+         // Where a page lives: file index and byte offset within that file
+         struct PageLocation {
+             size_t file;
+             uint64_t offset;
+         };
+
+         PageLocation Locate(page_id_t page_id) const;
+         std::shared_ptr<IOBatch> MakeBatch(IOType type, const std::vector<PageRequest> &requests);
+         void SubmitBatch(const std::shared_ptr<IOBatch> &batch);
+         void CheckAligned(const char *data) const;
+         void CheckWritable() const;
+         void OpenReadOnlyMapped();
+         void OpenDataFile(const std::string &name, bool direct_io);
+         void CloseFiles();
+
+         std::vector<DataFile> files_;  // files_[0] is db_file
+         bool direct_io_; // Files opened with O_DIRECT
+         bool read_only_; // File opened read-only and mapped
+         const char *mapped_data_; // Read-only mapping of the whole file (nullptr if not mapped or empty)
+         size_t mapped_size_;
          std::string file_name_; // Database file name
-         int32_t num_pages_;   // Number of pages in the file
-         std::vector<page_id_t> free_list_;  // Deallocated pages available for reuse
+         std::atomic<page_id_t> num_pages_;   // Number of pages in the tablespace
+         std::unique_ptr<AllocationBitmap> allocation_bitmap_;  // Persistent set of deallocated pages (<db_file>.bitmap)
+         std::unique_ptr<CompressedPageStore> compressed_store_; // Compressed page blocks (nullptr if uncompressed)
+
+         // Page reads and writes go straight to pread/pwrite and need no latch. Allocation
+         // state and the compressed page map are shared, so they are latched.
+         mutable std::mutex allocation_latch_;  // Guards allocation_bitmap_ and growing num_pages_
+         mutable std::mutex store_latch_;  // Guards compressed_store_
+
+         // Statistics (see DiskStats)
+         enum Counter : size_t {
+             PAGES_READ, PAGES_WRITTEN, PAGES_ALLOCATED, PAGES_REUSED, EXTENTS_ALLOCATED,
+             PAGES_DEALLOCATED, SYNCS, NUM_COUNTERS
+         };
+         StripedCounters<NUM_COUNTERS> counters_;
+         LatencyHistogram read_latency_;
+         LatencyHistogram write_latency_;
 
     };
 
 
-}
\ No newline at end of file
+}
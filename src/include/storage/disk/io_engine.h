@@ -0,0 +1,197 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+
+namespace dbengine {
+
+    enum class IOType {
+        READ,
+        WRITE
+    };
+
+    enum class IOEngineType {
+        AUTO,         // io_uring when the kernel allows it, thread pool otherwise
+        IO_URING,
+        THREAD_POOL
+    };
+
+    /**
+    * A single positional read or write against a file descriptor.
+    */
+    struct IORequest {
+        IOType type;
+        int fd;
+        uint64_t offset;
+        char *buffer;
+        size_t length;
+        ssize_t result;   // Bytes transferred, or -errno on failure
+    };
+
+    /**
+    * IOBatch groups requests that are submitted together and waited on together.
+    *
+    * Engines call CompleteRequest() once per request (from any thread); callers
+    * block in Wait() until every request in the batch has finished.
+    */
+    class IOBatch {
+        public:
+        explicit IOBatch(std::vector<IORequest> requests);
+
+        std::vector<IORequest> &GetRequests() { return requests_; }
+        const std::vector<IORequest> &GetRequests() const { return requests_; }
+
+        /**
+        * Block until every request in the batch has completed.
+        */
+        void Wait();
+
+        /**
+        * @return true if every request in the batch has completed
+        */
+        bool IsComplete();
+
+        /**
+        * Record the result of request `index`. Called by the engine.
+        */
+        void CompleteRequest(size_t index, ssize_t result);
+
+        private:
+        std::vector<IORequest> requests_;
+        std::mutex latch_;
+        std::condition_variable cv_;
+        size_t pending_;
+    };
+
+    /**
+    * IOEngine executes batches of positional I/O asynchronously.
+    */
+    class IOEngine {
+        public:
+        virtual ~IOEngine() = default;
+
+        /**
+        * Queue every request in the batch. Returns without waiting for completion.
+        */
+        void Submit(const std::shared_ptr<IOBatch> &batch) { Submit(batch, 0, batch->GetRequests().size()); }
+
+        /**
+        * Queue requests [begin, end) of the batch, so one batch can be spread over
+        * several engines (e.g. one per file). Returns without waiting for completion.
+        */
+        virtual void Submit(const std::shared_ptr<IOBatch> &batch, size_t begin, size_t end) = 0;
+
+        virtual const char *GetName() const = 0;
+
+        /**
+        * Create an engine of the given type.
+        * @param type requested engine; AUTO falls back to the thread pool if io_uring is unavailable
+        * @param queue_depth maximum number of requests in flight
+        */
+        static std::unique_ptr<IOEngine> Create(IOEngineType type, size_t queue_depth);
+    };
+
+    /**
+    * Portable engine: a fixed set of worker threads issuing pread/pwrite.
+    */
+    class ThreadPoolIOEngine : public IOEngine {
+        public:
+        explicit ThreadPoolIOEngine(size_t num_threads);
+        ~ThreadPoolIOEngine() override;
+
+        using IOEngine::Submit;
+        void Submit(const std::shared_ptr<IOBatch> &batch, size_t begin, size_t end) override;
+
+        const char *GetName() const override { return "thread_pool"; }
+
+        private:
+        struct Task {
+            std::shared_ptr<IOBatch> batch;
+            size_t index;
+        };
+
+        void WorkerLoop();
+
+        std::vector<std::thread> workers_;
+        std::deque<Task> queue_;
+        std::mutex latch_;
+        std::condition_variable cv_;
+        bool shutdown_;
+    };
+
+    /**
+    * Linux io_uring engine driven through the raw syscalls (no liburing dependency).
+    * A single reaper thread drains the completion queue and completes batches.
+    */
+    class IoUringIOEngine : public IOEngine {
+        public:
+        /**
+        * @throws std::runtime_error if io_uring is not supported or not permitted
+        */
+        explicit IoUringIOEngine(size_t queue_depth);
+        ~IoUringIOEngine() override;
+
+        using IOEngine::Submit;
+        void Submit(const std::shared_ptr<IOBatch> &batch, size_t begin, size_t end) override;
+
+        const char *GetName() const override { return "io_uring"; }
+
+        private:
+        struct InFlight {
+            std::shared_ptr<IOBatch> batch;
+            size_t index;
+            size_t done;   // Bytes transferred by earlier, short completions
+        };
+
+        void ReaperLoop();
+        int Enter(unsigned to_submit, unsigned min_complete, unsigned flags);
+        void PushSqe(uint8_t opcode, int fd, uint64_t offset, char *buffer, size_t length, uint64_t user_data);
+
+        // Helper: Queue what is left of a request (caller holds submit_latch_)
+        void PushRequest(InFlight *slot);
+
+        /**
+        * Hand every queued SQE to the kernel (caller holds submit_latch_). If the
+        * kernel refuses, the SQEs it did not take are withdrawn and their requests
+        * completed with the error, so no batch is left waiting on them.
+        * @return 0 on success, otherwise the errno the requests were failed with
+        */
+        int SubmitQueued();
+
+        int ring_fd_;
+
+        // Submission ring
+        void *sq_ptr_;
+        size_t sq_ring_size_;
+        unsigned *sq_head_;
+        unsigned *sq_tail_;
+        unsigned *sq_mask_;
+        unsigned *sq_array_;
+        void *sqes_;
+        size_t sqes_size_;
+        unsigned sq_entries_;
+
+        // Completion ring (may share the submission mapping)
+        void *cq_ptr_;
+        size_t cq_ring_size_;
+        unsigned *cq_head_;
+        unsigned *cq_tail_;
+        unsigned *cq_mask_;
+        void *cqes_;
+
+        std::mutex submit_latch_;
+        std::condition_variable space_cv_;
+        std::condition_variable reaper_cv_;  // Wakes the idle reaper on new work or shutdown
+        size_t in_flight_;
+        bool shutdown_;
+        std::thread reaper_;
+    };
+
+}
@@ -12,7 +12,10 @@
 namespace dbengine {
     class BPlusTree {
         public:
-        BPlusTree(BufferPoolManager *bpm, uint32_t max_size);
+        BPlusTree(BufferPool *bpm, uint32_t max_size);
+
+        // Gives the unused part of the tree's extent back to the disk manager
+        ~BPlusTree();
 
         bool Search(int32_t key, RID &rid);
 
@@ -38,9 +41,10 @@ namespace dbengine {
                                 page_id_t parent_page_id, uint32_t key_index);
 
 
-        BufferPoolManager *bpm_;
+        BufferPool *bpm_;
         page_id_t root_page_id_;
         uint32_t max_size_;
+        PageExtent extent_;  // Index pages are allocated from the tree's own extents
 
     };
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "common/rid.h"
 #include "storage/index/b_plus_tree_page.h"
 
+#include <cstddef>
 #include <cstdint>
 
 
@@ -20,9 +21,16 @@ namespace dbengine {
             // IMPORTANT: For leaf pages, keys start AFTER the next_page_id field!
             // Override the keys_ pointer from the base class which assumes internal page layout
             keys_ = reinterpret_cast<int32_t *>(data_ + sizeof(BPlusTreeLeafPageHeader));
-            rids_ = reinterpret_cast<RID *>(data_ + sizeof(BPlusTreeLeafPageHeader) + max_size * sizeof(int32_t));
+            rids_ = reinterpret_cast<RID *>(data_ + RidsOffset(max_size));
         };
 
+        /**
+        * Byte offset of the RID array: after the keys, rounded up to RID alignment.
+        */
+        static constexpr size_t RidsOffset(uint32_t max_size) {
+            return (sizeof(BPlusTreeLeafPageHeader) + max_size * sizeof(int32_t) + alignof(RID) - 1) / alignof(RID) * alignof(RID);
+        }
+
         // RIDs arrays - Store RIDs (one per key)
         inline RID GetRID(uint32_t index) const { return rids_[index]; }
 
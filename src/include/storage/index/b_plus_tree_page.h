@@ -38,7 +38,7 @@ namespace dbengine {
         void SetSize(uint32_t size);
 
         // Page ID getters and setters
-        uint32_t GetPageId() const { return GetHeader()->page_id; }
+        page_id_t GetPageId() const { return GetHeader()->page_id; }
 
         void SetPageId(page_id_t page_id);
 
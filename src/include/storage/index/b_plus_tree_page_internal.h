@@ -4,6 +4,7 @@
 #include "common/rid.h"
 #include "storage/index/b_plus_tree_page.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <algorithm>
 
@@ -13,9 +14,16 @@ namespace dbengine {
         // Add your public and private members here
         public:
         BPlusTreeInternalPage(char *data, uint32_t max_size) : BPlusTreePage(data, max_size) {
-            child_page_ids_ = reinterpret_cast<page_id_t *>(data_ + sizeof(BPlusTreePageHeader) + max_size * sizeof(int32_t));
+            child_page_ids_ = reinterpret_cast<page_id_t *>(data_ + ChildrenOffset(max_size));
         };
 
+        /**
+        * Byte offset of the child id array: after the keys, rounded up to page id alignment.
+        */
+        static constexpr size_t ChildrenOffset(uint32_t max_size) {
+            return (sizeof(BPlusTreePageHeader) + max_size * sizeof(int32_t) + alignof(page_id_t) - 1) / alignof(page_id_t) * alignof(page_id_t);
+        }
+
         // Child page IDs arrays - Store child page IDs (one more than keys)
         inline page_id_t GetChildPageId(uint32_t index) const {
             return child_page_ids_[index];
@@ -9,17 +9,22 @@
 namespace dbengine {
 
     struct Slot {
-        uint32_t offset;
+        uint32_t offset;  // Of the record; for a deleted slot, the next free slot (INVALID_SLOT_NUM if last)
         uint32_t size;
         uint32_t generation;
     };
 
+    // End of the free slot chain
+    static constexpr uint32_t INVALID_SLOT_NUM = UINT32_MAX;
+
 
     struct PageHeader {
         uint32_t num_slots;
         uint32_t num_records;
         uint32_t free_space_pointer;
-        uint32_t page_id;
+        page_id_t page_id;
+        page_id_t next_page_id;  // Next page of the same table heap (INVALID_PAGE_ID if last)
+        uint32_t free_slot_head;  // Most recently deleted slot, chained through the deleted slots
     };
 
 
@@ -31,7 +36,7 @@ namespace dbengine {
         * Initialize an empty page 
         */
 
-        void Init(int32_t page_id);
+        void Init(page_id_t page_id);
 
         /**
         * Insert a record into the page.
@@ -39,6 +44,7 @@ namespace dbengine {
         * @param size size of the record
         * @param rid output parameter - the RID of the inserted record
         * @return true if the insert succeeds, false if not enough space 
+        * (the page is compacted first when dead records would leave enough)
         */
 
         bool InsertRecord(const char *data, uint32_t size, RID &rid);
@@ -49,7 +55,15 @@ namespace dbengine {
         * @param data output buffer to write record data
         * @return true if the record exists, false if deleted or invalid
          */
-         bool GetRecord(const RID &rid, char *data);
+         bool GetRecord(const RID &rid, char *data) const;
+
+         /**
+         * Get a record in place, without copying it.
+         * @param rid the record ID to fetch
+         * @param size output parameter - the size of the record
+         * @return the record's bytes inside the page, or nullptr if deleted or invalid
+         */
+         const char *GetRecordData(const RID &rid, uint32_t *size) const;
 
          /**
          * Delete a record from the page.
@@ -59,11 +73,12 @@ namespace dbengine {
          bool DeleteRecord(const RID &rid);
 
          /**
-         * Update a record in palce (if new size fits in old space) 
+         * Update a record in palce (if new size fits in old space); a larger record
+         * moves within the page, compacting it if need be. The RID stays the same.
          * @param rid the record ID to update
          * @param data new record data
          * @param size size of new record
-         * @return true if udpate succeeds, false if not enough space 
+         * @return true if udpate succeeds, false if not enough space (the old record is kept)
          */
          bool UpdateRecord(const RID &rid, const char *data, uint32_t size);
 
@@ -77,13 +92,34 @@ namespace dbengine {
           /** 
            * Get page ID
            */
-           int32_t GetPageId() const;
+           page_id_t GetPageId() const;
+
+           /**
+           * Get the next page of the table heap this page belongs to
+           */
+           page_id_t GetNextPageId() const { return GetHeader()->next_page_id; }
+
+           /**
+           * Link this page to the next page of its table heap
+           */
+           void SetNextPageId(page_id_t next_page_id) { GetHeader()->next_page_id = next_page_id; }
 
            /**
            * Get free space available in the page 
            */
            uint32_t GetFreeSpace() const;
 
+           /**
+           * Get space held by deleted and shrunk records, which Compact() gives back
+           */
+           uint32_t GetReclaimableSpace() const;
+
+           /**
+           * Slide the live records together at the end of the page, turning dead space
+           * into free space. Slot numbers, and so RIDs, don't change.
+           */
+           void Compact();
+
            private: 
            // Helper: Get pointer to page header
            PageHeader *GetHeader() {
@@ -103,6 +139,13 @@ namespace dbengine {
             return reinterpret_cast<const Slot *>(data_ + sizeof(PageHeader));
            }
 
+           // Helper: Total size of the live records
+           uint32_t GetLiveBytes() const;
+
+           // Helper: Make size bytes of free space above slot_array_end, compacting if
+           // that is enough; false (page untouched) if even compaction isn't
+           bool MakeRoom(uint32_t size, uint32_t slot_array_end);
+
            // Helper: Get pointer to record data
            Slot *GetSlot(uint32_t slot_num) {
             return GetSlotArray() + slot_num;
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "common/config.h"
+
+namespace dbengine {
+
+    /**
+    * CRC32C (Castagnoli) of a buffer. Uses the SSE4.2 / ARMv8 crc32 instructions
+    * when the CPU has them, and a slicing-by-8 table otherwise.
+    */
+    uint32_t Crc32c(const char *data, size_t length);
+
+    /**
+    * Table-driven CRC32C, always available. Exposed for tests and benchmarks.
+    */
+    uint32_t Crc32cSoftware(const char *data, size_t length);
+
+    /**
+    * @return true if Crc32c() uses the hardware instruction on this CPU
+    */
+    bool Crc32cHardwareAvailable();
+
+    /**
+    * Write the checksum of the page contents into the page trailer
+    * (the last PAGE_CHECKSUM_SIZE bytes). Called before a page goes to disk.
+    */
+    void StampPageChecksum(char *page_data);
+
+    /**
+    * Check the page trailer against the page contents. A page that is all zeros
+    * (allocated or preallocated but never written) is accepted.
+    * @return true if the page is intact
+    */
+    bool VerifyPageChecksum(const char *page_data);
+
+}
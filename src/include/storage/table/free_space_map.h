@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "common/config.h"
+#include "storage/buffer/buffer_pool.h"
+#include "storage/page/page.h"
+
+namespace dbengine {
+
+    struct FreeSpaceMapPageHeader {
+        page_id_t page_id;
+        page_id_t next_page_id;  // Next page of the same map (INVALID_PAGE_ID if last)
+        uint32_t num_entries;
+    };
+
+    /**
+    * FreeSpaceMap records roughly how much room each page of a table heap has
+    * left, so inserts can reuse space freed by deletes instead of growing the heap.
+    *
+    * Each heap page gets a 4-bit category: category c means at least
+    * c * FSM_CATEGORY_BYTES bytes are free or reclaimable by compaction. The
+    * categories are kept in dedicated pages, two per byte in heap page order,
+    * chained from GetFirstPageId(); a copy is cached in memory for lookups, and
+    * a map page is only written when a category changes.
+    *
+    * Categories are a lower bound taken when the heap last touched the page, so
+    * a page found here has room for the record unless someone got there first.
+    *
+    * Map pages are latched only after latch_ is released, so a caller holding a
+    * map page guard may still ask the map for a category.
+    */
+    class FreeSpaceMap {
+        public:
+        // Free space covered by one category step (16 steps per page)
+        static constexpr uint32_t FSM_CATEGORY_BYTES = PAGE_SIZE / 16;
+
+        // Categories per map page
+        static constexpr size_t FSM_ENTRIES_PER_PAGE = (PAGE_CHECKSUM_OFFSET - sizeof(FreeSpaceMapPageHeader)) * 2;
+
+        /**
+        * Map pages are allocated outside the heap's extents, which stay contiguous for scans.
+        */
+        explicit FreeSpaceMap(BufferPool *bpm);
+
+        /**
+        * Load the map of a reopened heap from its map pages.
+        * @param first_map_page_id the map's first page (GetFirstPageId() when it was written)
+        * @param heap_page_ids the heap's pages, in chain order
+        * @return false if the map pages can't be read or don't cover every heap page
+        */
+        bool Open(page_id_t first_map_page_id, const std::vector<page_id_t> &heap_page_ids);
+
+        /**
+        * Rewrite the map of a reopened heap whose map pages Open() rejected. The old
+        * chain's pages are rewritten in place, extended or trimmed as needed, so the
+        * first page id only changes if the old first page was unusable.
+        * @param free_spaces AvailableSpace() of each heap page, in chain order
+        * @return false if a map page could not be written or created
+        */
+        bool Rebuild(page_id_t first_map_page_id, const std::vector<page_id_t> &heap_page_ids,
+                     const std::vector<uint32_t> &free_spaces);
+
+        /**
+        * Start tracking a page appended to the heap.
+        * @return false if a new map page was needed and could not be created
+        */
+        bool AddPage(page_id_t page_id, uint32_t free_space);
+
+        /**
+        * Record a heap page's free space after an insert, update or delete.
+        */
+        void Update(page_id_t page_id, uint32_t free_space);
+
+        /**
+        * @param skip_page_id a page the caller just tried, not to be offered again
+        * @return a page with room for a record of record_size bytes, earliest in the
+        * heap first; INVALID_PAGE_ID if the map knows of none
+        */
+        page_id_t FindPage(uint32_t record_size, page_id_t skip_page_id = INVALID_PAGE_ID);
+
+        /**
+        * @return the category recorded for a page (0 if not tracked)
+        */
+        uint8_t GetCategory(page_id_t page_id);
+
+        inline page_id_t GetFirstPageId() const { return map_page_ids_.empty() ? INVALID_PAGE_ID : map_page_ids_[0]; }
+
+        /**
+        * @return space of a heap page that an insert can use: free space plus dead
+        * space, which the insert compacts away if it has to
+        */
+        static uint32_t AvailableSpace(const Page *page);
+
+        private:
+            // Helper: Category of a page with free_space bytes to spare
+            static uint8_t ToCategory(uint32_t free_space);
+
+            // Helper: Set a cached category and move the search cursors back to it (caller holds latch_)
+            void SetCategory(size_t index, uint8_t category);
+
+            // Helper: Write the cached category of one entry through to its map page (without latch_)
+            void WriteEntry(size_t index);
+
+            // Helper: Replace the cached map with one read or rebuilt from the map pages
+            void Load(std::vector<page_id_t> map_page_ids, const std::vector<page_id_t> &heap_page_ids,
+                      std::vector<uint8_t> categories);
+
+            BufferPool *bpm_;
+            std::mutex grow_latch_;  // Serializes AddPage, Open and Rebuild, which latch map pages
+            std::mutex latch_;  // Guards the fields below
+            std::vector<page_id_t> map_page_ids_;  // Map pages, in chain order
+            std::vector<page_id_t> heap_page_ids_;  // Heap pages, in the order they were added
+            std::vector<uint8_t> categories_;  // Cached category of each heap page
+            std::unordered_map<page_id_t, size_t> index_of_;  // Heap page id -> position in the map
+            std::array<size_t, 16> search_from_{};  // Per category: no earlier entry has at least that category
+    };
+}
@@ -1,13 +1,24 @@
 #pragma once
 #include "storage/page/page.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
 #include "storage/buffer/buffer_pool_manager.h"
+#include "storage/table/free_space_map.h"
 
 namespace dbengine {
     class TableHeap {
         public:
         // Constructor
-        TableHeap(BufferPoolManager *bpm);
+        TableHeap(BufferPool *bpm);
+
+        // Reopen a heap written earlier: follows the page chain from first_page_id and loads
+        // the free space map from free_space_map_page_id, rebuilding it in place if it doesn't
+        // match. A map whose first page was unusable moves, so callers that store the map's
+        // page id must re-read GetFreeSpaceMapPageId() after opening.
+        TableHeap(BufferPool *bpm, page_id_t first_page_id, page_id_t free_space_map_page_id);
+
+        // Destructor: gives the unused part of the heap's extent back to the disk manager
+        ~TableHeap();
 
         // Insert a tuple, return RID where it was stored
         bool InsertTuple(const Tuple &tuple, RID &rid);
@@ -15,6 +26,11 @@ namespace dbengine {
         // Get a tuple by RID
         bool GetTuple(const RID &rid, Tuple &tuple);
 
+        // Get a tuple by RID without copying it: the view points into the page, which
+        // guard keeps pinned and read-latched; the view is valid until guard is dropped.
+        // A guard reused across lookups stays on its page if the next RID is on it too.
+        bool GetTupleView(const RID &rid, ReadPageGuard &guard, TupleView &view);
+
         // Delete a tuple by RID
         bool DeleteTuple(const RID &rid);
 
@@ -23,9 +39,23 @@ namespace dbengine {
 
         inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
+        // Number of pages chained in the heap
+        inline size_t GetNumPages() const { return num_pages_; }
+
+        inline FreeSpaceMap *GetFreeSpaceMap() { return &free_space_map_; }
+
+        // First page of the free space map, to pass back when the heap is reopened
+        inline page_id_t GetFreeSpaceMapPageId() const { return free_space_map_.GetFirstPageId(); }
+
         private:
-            BufferPoolManager *bpm_;
+            BufferPool *bpm_;
             page_id_t first_page_id_;
             page_id_t last_page_id_;
+            size_t num_pages_;
+            PageExtent extent_;  // Pages of this heap are allocated from its own extents
+            FreeSpaceMap free_space_map_;  // Room left in each page, for inserts to reuse
+
+            // Helper: Insert into one page and record its remaining space
+            bool InsertIntoPage(page_id_t page_id, const Tuple &tuple, RID &rid);
     };
 }
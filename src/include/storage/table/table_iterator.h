@@ -2,83 +2,181 @@
 
 #include "storage/table/table_heap.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
 #include "common/rid.h"
+#include <memory>
+#include <vector>
 
 namespace dbengine {
 
 class TableIterator {
 public:
-    TableIterator(TableHeap *table_heap, BufferPoolManager *bpm)
-        : table_heap_(table_heap), bpm_(bpm),
+    // With a ring, pages the scan misses on are read into the ring's frames
+    // (see ScanRing); the ring must outlive the iterator.
+    TableIterator(TableHeap *table_heap, BufferPool *bpm, ScanRing *ring = nullptr)
+        : bpm_(bpm), ring_(ring),
           current_page_id_(table_heap->GetFirstPageId()),
-          current_slot_(0), current_page_(nullptr) {
+          current_slot_(0), snapshot_page_id_(INVALID_PAGE_ID) {}
 
-        if (current_page_id_ != INVALID_PAGE_ID) {
-            current_page_ = bpm_->FetchPage(current_page_id_);
+    // Answered from the page the scan is on: the page under the last view if one is
+    // held, else the copy Next(Tuple &) serves rows from. A page is fetched only
+    // when the scan moves on to it.
+    bool HasNext() {
+        if (guard_.IsValid()) {
+            return SeekLive(&guard_) != nullptr;
         }
+        return SeekSnapshot() != nullptr;
     }
 
-    ~TableIterator() {
-        if (current_page_ != nullptr) {
-            bpm_->UnpinPage(current_page_id_, false);
+    // Next row, copied. Each page is fetched once: its rows are served from a copy
+    // of the page taken on arrival, so no latch is held between calls.
+    bool Next(Tuple &tuple, RID &rid) {
+        const Slot *slot = SeekSnapshot();
+        if (slot == nullptr) {
+            return false;
         }
+
+        rid = RID(current_page_id_, current_slot_, slot->generation);
+        current_slot_++;
+        tuple.Assign(snapshot_.get() + slot->offset, slot->size);
+        tuple.SetRID(rid);
+        return true;
     }
 
-    bool HasNext() {
-        if (current_page_ == nullptr) {
+    // Next row without a copy: the view points into the page, which stays pinned and
+    // read-latched until the scan moves past it, Release() is called or the iterator
+    // is destroyed. Don't write to the table while holding a view.
+    bool Next(TupleView &view, RID &rid) {
+        const Slot *slot = SeekLive(&guard_);
+        if (slot == nullptr) {
             return false;
         }
 
-        PageHeader *header = reinterpret_cast<PageHeader *>(current_page_->GetData());
+        rid = RID(current_page_id_, current_slot_, slot->generation);
+        current_slot_++;
+        view = TupleView(guard_.GetData() + slot->offset, slot->size, rid);
+        return true;
+    }
 
-        while (current_slot_ < header->num_slots) {
-            Slot *slot_array = reinterpret_cast<Slot *>(
-                current_page_->GetData() + sizeof(PageHeader)
-            );
-            Slot *slot = &slot_array[current_slot_];
+    // All live rows of the next page that has any, as views into that page: one
+    // fetch and one pass over the slot array per page. The page stays pinned and
+    // read-latched until the next call, Release() or the iterator's destruction.
+    // @return number of rows in batch; 0 at the end of the heap
+    size_t NextBatch(std::vector<TupleView> &batch) {
+        batch.clear();
+        if (SeekLive(&guard_) == nullptr) {
+            return 0;
+        }
 
+        const char *data = guard_.GetData();
+        const PageHeader *header = reinterpret_cast<const PageHeader *>(data);
+        const Slot *slot_array = reinterpret_cast<const Slot *>(data + sizeof(PageHeader));
+        for (; current_slot_ < header->num_slots; current_slot_++) {
+            const Slot *slot = &slot_array[current_slot_];
             if (slot->size > 0) {
-                return true;
+                batch.emplace_back(data + slot->offset, slot->size, RID(current_page_id_, current_slot_, slot->generation));
             }
-            current_slot_++;
         }
+        return batch.size();
+    }
 
-        return false;
+    // Release the page under the last view
+    void Release() {
+        guard_.Drop();
     }
 
-    bool Next(Tuple &tuple, RID &rid) {
-        if (!HasNext()) {
-            return false;
+private:
+    // Copy the current page for Next(Tuple &); false if it cannot be fetched
+    bool TakeSnapshot() {
+        if (snapshot_ == nullptr) {
+            snapshot_.reset(new char[PAGE_SIZE]);
+        }
+
+        // A view may be holding the page already: copy it from there rather than latch it twice
+        if (guard_.IsValid() && guard_.GetPageId() == current_page_id_) {
+            memcpy(snapshot_.get(), guard_.GetData(), PAGE_SIZE);
+            guard_.Drop();
+        } else {
+            guard_.Drop();
+            ReadPageGuard guard = ring_ != nullptr ? bpm_->FetchPageRead(current_page_id_, ring_)
+                                                   : bpm_->FetchPageRead(current_page_id_);
+            if (!guard.IsValid()) {
+                return false;
+            }
+            memcpy(snapshot_.get(), guard.GetData(), PAGE_SIZE);
         }
+        snapshot_page_id_ = current_page_id_;
+        return true;
+    }
 
-        PageHeader *header = reinterpret_cast<PageHeader *>(current_page_->GetData());
-        Slot *slot_array = reinterpret_cast<Slot *>(
-            current_page_->GetData() + sizeof(PageHeader)
-        );
+    // Same as SeekLive, over the copy of each page: returns the slot in snapshot_,
+    // or nullptr at the end. Each page is copied once, when the scan reaches it.
+    const Slot *SeekSnapshot() {
+        while (current_page_id_ != INVALID_PAGE_ID) {
+            if (snapshot_page_id_ != current_page_id_ && !TakeSnapshot()) {
+                return nullptr;
+            }
 
-        while (current_slot_ < header->num_slots) {
-            Slot *slot = &slot_array[current_slot_];
+            const PageHeader *header = reinterpret_cast<const PageHeader *>(snapshot_.get());
+            const Slot *slot_array = reinterpret_cast<const Slot *>(snapshot_.get() + sizeof(PageHeader));
+            while (current_slot_ < header->num_slots) {
+                const Slot *slot = &slot_array[current_slot_];
+                if (slot->size > 0) {
+                    return slot;
+                }
+                current_slot_++;
+            }
 
-            if (slot->size > 0) {
-                rid = RID(current_page_id_, current_slot_, slot->generation);
+            // Page exhausted: move on to the next page of the heap
+            current_page_id_ = header->next_page_id;
+            current_slot_ = 0;
+        }
+        return nullptr;
+    }
+
+    // Move to the next live slot at or after the current position, following the
+    // heap's page chain (sequential fetches let the buffer pool read ahead).
+    // Returns the slot, with its page latched by *guard, or nullptr at the end.
+    const Slot *SeekLive(ReadPageGuard *guard) {
+        while (current_page_id_ != INVALID_PAGE_ID) {
+            // Still on the page of the last view: keep it rather than latch it twice
+            if (!guard->IsValid() || guard->GetPageId() != current_page_id_) {
+                guard->Drop();
+                *guard = ring_ != nullptr ? bpm_->FetchPageRead(current_page_id_, ring_) : bpm_->FetchPageRead(current_page_id_);
+                if (!guard->IsValid()) {
+                    return nullptr;
+                }
+                // This fetch may see rows added since the copy was taken: retake it when needed
+                snapshot_page_id_ = INVALID_PAGE_ID;
+            }
 
-                if (table_heap_->GetTuple(rid, tuple)) {
-                    current_slot_++;
-                    return true;
+            const char *data = guard->GetData();
+            const PageHeader *header = reinterpret_cast<const PageHeader *>(data);
+            const Slot *slot_array = reinterpret_cast<const Slot *>(data + sizeof(PageHeader));
+            while (current_slot_ < header->num_slots) {
+                const Slot *slot = &slot_array[current_slot_];
+                if (slot->size > 0) {
+                    return slot;
                 }
+                current_slot_++;
             }
-            current_slot_++;
+
+            // Page exhausted: move on to the next page of the heap
+            current_page_id_ = guard->GetPage()->GetNextPageId();
+            current_slot_ = 0;
+            guard->Drop();
         }
 
-        return false;
+        return nullptr;
     }
 
-private:
-    TableHeap *table_heap_;
-    BufferPoolManager *bpm_;
+    BufferPool *bpm_;
+    ScanRing *ring_;
     page_id_t current_page_id_;
     uint32_t current_slot_;
-    Page *current_page_;
+    ReadPageGuard guard_;  // Page under the last view handed out
+    std::unique_ptr<char[]> snapshot_;  // Copy of the page Next(Tuple &) is serving rows from
+    page_id_t snapshot_page_id_;
 };
 
 }
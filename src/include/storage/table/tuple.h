@@ -8,30 +8,49 @@ namespace dbengine {
     class Tuple {
         // Constructors
     public:
-        Tuple() : data_(nullptr), size_(0) {}; 
+        Tuple() : data_(nullptr), size_(0), capacity_(0) {};
 
-        Tuple(const char *data, uint32_t size) : size_(size) {
+        Tuple(const char *data, uint32_t size) : size_(size), capacity_(size) {
             data_ = new char[size_];
             std::memcpy(data_, data, size_);
-        }; 
+        };
 
         ~Tuple() { delete[] data_; };
 
         // Copy constructor and assignment (important!)
-        Tuple(const Tuple &other) : size_(other.size_) {
+        Tuple(const Tuple &other) : size_(other.size_), capacity_(other.size_), rid_(other.rid_) {
             data_ = new char[size_];
             std::memcpy(data_, other.data_, size_);
         };
 
         Tuple& operator=(const Tuple &other) {
             if (this != &other) {
-                delete[] data_;
-                data_ = new char[other.size_];
-                std::memcpy(data_, other.data_, other.size_);
+                Assign(other.data_, other.size_);
+                rid_ = other.rid_;
             }
             return *this;
         };
 
+        Tuple(Tuple &&other) noexcept : data_(other.data_), size_(other.size_), capacity_(other.capacity_), rid_(other.rid_) {
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+
+        Tuple& operator=(Tuple &&other) noexcept {
+            if (this != &other) {
+                delete[] data_;
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                rid_ = other.rid_;
+                other.data_ = nullptr;
+                other.size_ = 0;
+                other.capacity_ = 0;
+            }
+            return *this;
+        }
+
         // Getters
         inline const char* GetData() const { return data_; }
         inline char* GetData() { return data_; }
@@ -41,15 +60,29 @@ namespace dbengine {
         inline RID GetRID() const { return rid_; }
         inline void SetRID(const RID &rid) { rid_ = rid; }
 
+        // Resize to size bytes; the buffer is only reallocated when it grows, so a
+        // tuple reused row after row allocates once. The contents are not kept.
         void Allocate(uint32_t size) {
-            delete[] data_;
-            data_ = new char[size];
+            if (size > capacity_) {
+                delete[] data_;
+                data_ = new char[size];
+                capacity_ = size;
+            }
             size_ = size;
         }
-    
+
+        // Copy a record into the tuple (see Allocate)
+        void Assign(const char *data, uint32_t size) {
+            Allocate(size);
+            if (size > 0) {
+                std::memcpy(data_, data, size);
+            }
+        }
+
     private:
         char *data_;
         uint32_t size_;
+        uint32_t capacity_;
         RID rid_;
     };
-}
\ No newline at end of file
+}
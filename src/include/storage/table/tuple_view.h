@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+
+namespace dbengine {
+
+    /**
+    * TupleView is a non-owning reference to a record: a pointer, a length and
+    * the record's RID. Scans hand out views straight into the pinned frame, so
+    * rows are read without a copy or an allocation.
+    *
+    * A view is only valid while the page guard it came from is held: see
+    * TableHeap::GetTupleView and TableIterator::Next(TupleView &, RID &). Copy
+    * the row into a Tuple (Tuple::Assign) to keep it longer.
+    */
+    class TupleView {
+        public:
+        TupleView() : data_(nullptr), size_(0) {}
+
+        TupleView(const char *data, uint32_t size, const RID &rid) : data_(data), size_(size), rid_(rid) {}
+
+        // View of an owning tuple, valid while the tuple is neither changed nor destroyed
+        explicit TupleView(const Tuple &tuple) : data_(tuple.GetData()), size_(tuple.GetSize()), rid_(tuple.GetRID()) {}
+
+        inline const char *GetData() const { return data_; }
+        inline uint32_t GetSize() const { return size_; }
+        inline RID GetRID() const { return rid_; }
+
+        private:
+            const char *data_;
+            uint32_t size_;
+            RID rid_;
+    };
+}
@@ -1,148 +1,797 @@
 #include "storage/buffer/buffer_pool_manager.h"
+#include "storage/page/page_checksum.h"
+#include "storage/buffer/warmup_list.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
 
 namespace dbengine {
 
-BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager) : pool_size_(pool_size), disk_manager_(disk_manager) {
+BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager, bool use_huge_pages,
+                                     ReplacerType replacer_type)
+    : BufferPoolManager(pool_size, disk_manager, use_huge_pages, replacer_type, 0, 1) {}
+
+BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager, bool use_huge_pages,
+                                     ReplacerType replacer_type, size_t partition_index, size_t num_partitions)
+    : pool_size_(0), num_frames_(0), allocated_frames_(0), use_huge_pages_(use_huge_pages),
+      frame_blocks_(new std::unique_ptr<FrameHeader[]>[MAX_POOL_FRAMES / FRAME_BLOCK_SIZE]), num_frame_blocks_(0),
+      disk_manager_(disk_manager), partition_index_(partition_index), num_partitions_(num_partitions),
+      shards_(NUM_PAGE_TABLE_SHARDS),
+      read_ahead_window_(std::min<size_t>(DEFAULT_READ_AHEAD_WINDOW, pool_size / 4)),
+      last_fetched_page_id_(INVALID_PAGE_ID), sequential_run_(0), read_ahead_end_(0),
+      bg_writer_stop_(false), bg_writer_wake_(false), bg_writer_rate_(DEFAULT_BG_WRITER_RATE),
+      warmup_stop_(false) {
+
+    if (pool_size > MAX_POOL_FRAMES) {
+        throw std::invalid_argument("Buffer pool size exceeds MAX_POOL_FRAMES");
+    }
 
-    // Allocate the buffer pool (array of Pages)
-    pages_ = new Page[pool_size_];
+    // Create the replacer (can track all frames)
+    replacer_ = Replacer::Create(replacer_type, pool_size);
 
-    // Create the LRU replacer (can track all frames)
-    replacer_ = new LRUReplacer(pool_size_);
+    // Size each page table shard for an even share of the frames; skewed shards grow
+    for (auto &shard : shards_) {
+        shard.page_table.Reserve(pool_size / NUM_PAGE_TABLE_SHARDS + 1);
+    }
 
-    // Initialize the pin counts and dirty flags for each frame
-    pin_count_.resize(pool_size_, 0);
-    is_dirty_.resize(pool_size_, false);
+    // Allocate the PAGE_SIZE-aligned frames, chunk by chunk; all start as free (no pages loaded)
+    Grow(pool_size);
 
-    // All frames start as free (no pages loaded)
-    for (size_t i = 0; i < pool_size_; i++) {
-        free_list_.push_back(static_cast<frame_id_t>(i));
+    // Mapped files are read-only: nothing will ever need writing, only verifying once
+    if (disk_manager_->IsReadOnlyMapped()) {
+        size_t num_words = (static_cast<size_t>(disk_manager_->GetNumPages()) + 63) / 64;
+        mapped_verified_.reset(new std::atomic<uint64_t>[num_words]());
+    } else {
+        bg_writer_ = std::thread(&BufferPoolManager::BackgroundWriterLoop, this);
     }
 }
 
 BufferPoolManager::~BufferPoolManager() {
-    // Flush all dirty pages before destruction
+    StopWarmup();
+    // Stop the background writer; FlushAllPages below writes whatever it left
+    if (bg_writer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(bg_writer_latch_);
+            bg_writer_stop_ = true;
+        }
+        bg_writer_cv_.notify_one();
+        bg_writer_.join();
+    }
+    // No read may still be writing into the frames
+    ReapReads(true);
+    // Flush all dirty pages before destruction (saving the warm-up list); the chunks free the frames
     FlushAllPages();
-    // Free the buffer pool array
-    delete[] pages_;
-    // Free the LRU replacer
-    delete replacer_;
-
 }
 
 void BufferPoolManager::FlushAllPages() {
-    // Incrementing through all frames
-    for (size_t i = 0; i < pool_size_; i++) {
+    // A checkpoint also records what is resident, for the next start's warm-up
+    SaveWarmupList();
+
+    std::lock_guard<std::mutex> flush_lock(flush_latch_);
 
-        // If page is not dirty, skip it
-        if (!is_dirty_[i]) {
+    // Collect every dirty frame holding a valid page. Each one is pinned so it can't
+    // be evicted or deleted while the write is in progress.
+    std::vector<frame_id_t> dirty_frames;
+    // Frames out of service may still hold dirty pages until drained
+    size_t num_frames = num_frames_;
+    for (size_t i = 0; i < num_frames; i++) {
+        FrameHeader &frame = Frame(static_cast<frame_id_t>(i));
+        page_id_t page_id = frame.page_id.load();
+        if (page_id == INVALID_PAGE_ID || (!frame.is_dirty.load() && !frame.writing_back.load())) {
             continue;
         }
 
-        // Get the page from the buffer pool
-        Page *page = &pages_[i];
+        PageTableShard &shard = ShardFor(page_id);
+        std::lock_guard<std::mutex> lock(shard.latch);
+        if (shard.page_table.Find(page_id) != static_cast<frame_id_t>(i) ||
+            frame.state.load() != FrameState::READY) {
+            continue; // Changed hands since we looked
+        }
+        PinForFlush(static_cast<frame_id_t>(i));
+        dirty_frames.push_back(static_cast<frame_id_t>(i));
+    }
 
-        // If page is not valid, skip it
-        if (page->GetPageId() == INVALID_PAGE_ID) {
-            continue;
+    if (dirty_frames.empty()) {
+        return;
+    }
+    std::sort(dirty_frames.begin(), dirty_frames.end(), [this](frame_id_t a, frame_id_t b) {
+        return Frame(a).page_id.load() < Frame(b).page_id.load();
+    });
+
+    // Pages are copied and written a batch at a time; each copy is marked clean as it
+    // is taken, so on failure every page copied so far is marked dirty again
+    FrameArena copies(std::min(dirty_frames.size(), FLUSH_BATCH_PAGES), false);
+    std::vector<frame_id_t> cleaned;
+    std::vector<PageRequest> batch;
+    try {
+        size_t next = 0;
+        while (next < dirty_frames.size()) {
+            batch.clear();
+            for (; next < dirty_frames.size() && batch.size() < FLUSH_BATCH_PAGES; next++) {
+                frame_id_t frame_id = dirty_frames[next];
+                WaitForWriteBack(Frame(frame_id));
+                char *copy = copies.GetFrames()[batch.size()].GetData();
+                if (CopyDirtyPage(frame_id, copy)) {
+                    StampPageChecksum(copy);
+                    batch.push_back(PageRequest{Frame(frame_id).page_id.load(), copy});
+                    cleaned.push_back(frame_id);
+                }
+            }
+            // Sorted, coalesced write-back
+            if (!batch.empty()) {
+                disk_manager_->WritePagesCoalesced(batch);
+            }
+        }
+        // A single sync at the end
+        disk_manager_->Sync();
+    } catch (...) {
+        for (frame_id_t frame_id : cleaned) {
+            Frame(frame_id).is_dirty = true;
         }
+        for (frame_id_t frame_id : dirty_frames) {
+            UnpinAfterFlush(frame_id);
+        }
+        throw;
+    }
+    counters_.Add(FLUSH_WRITES, cleaned.size());
+    for (frame_id_t frame_id : dirty_frames) {
+        UnpinAfterFlush(frame_id);
+    }
+}
+
+void BufferPoolManager::PinForFlush(frame_id_t frame_id) {
+    if (Frame(frame_id).pin_count.fetch_add(1) == 0) {
+        replacer_->Pin(frame_id);
+    }
+}
 
-        FlushPage(page->GetPageId());
+void BufferPoolManager::UnpinAfterFlush(frame_id_t frame_id) {
+    if (Frame(frame_id).pin_count.fetch_sub(1) == 1) {
+        replacer_->Unpin(frame_id);
+    }
+}
+
+bool BufferPoolManager::CopyDirtyPage(frame_id_t frame_id, char *buffer) {
+    FrameHeader &frame = Frame(frame_id);
+    // No write guard is mid-update while we hold the shared latch, so the copy is a whole page
+    std::shared_lock<std::shared_mutex> lock(frame.rwlatch);
+    if (!frame.is_dirty.load()) {
+        return false;
     }
+    std::memcpy(buffer, FramePage(frame_id)->GetData(), PAGE_SIZE);
+    // Cleared before the write: a change made from here on dirties it again
+    frame.is_dirty = false;
+    return true;
+}
+
+bool BufferPoolManager::TakeFreeFrame(frame_id_t *frame_id) {
+    std::lock_guard<std::mutex> lock(free_list_latch_);
+    if (free_list_.empty()) {
+        return false;
     }
+    *frame_id = free_list_.front();
+    free_list_.pop_front();
+    return true;
+}
 
-bool BufferPoolManager::FindVictimFrame(frame_id_t *frame_id) {
-    // Check if there's a free frame
-    if (!free_list_.empty()) {
-        *frame_id = free_list_.front();
-        free_list_.pop_front();
+bool BufferPoolManager::AcquireRingFrame(ScanRing *ring, page_id_t page_id, frame_id_t *frame_id, bool may_wait) {
+    // Recycle the frame the scan used longest ago, if it still holds the scan's page and
+    // nobody holds it now; the rest of the pool is left alone
+    if (ring->entries_.size() == ring->num_frames_) {
+        ScanRing::Entry &oldest = ring->entries_[ring->next_];
+        ring->next_ = (ring->next_ + 1) % ring->num_frames_;
+        if (Frame(oldest.frame_id).page_id.load() == oldest.page_id && EvictFrame(oldest.frame_id)) {
+            if (static_cast<size_t>(oldest.frame_id) < pool_size_.load()) {
+                counters_.Add(RING_REUSES);
+                oldest.page_id = page_id;
+                *frame_id = oldest.frame_id;
+                return true;
+            }
+            ReturnFrame(oldest.frame_id); // Out of service since a shrink: retire it
+        }
+
+        // In use elsewhere: it leaves the ring, and the frame taken instead takes its place
+        if (!AcquireFrame(frame_id, may_wait)) {
+            return false;
+        }
+        oldest = ScanRing::Entry{*frame_id, page_id};
         return true;
     }
 
-    // No free frames, try to evict a frame using the replacer
-    if (!replacer_->Victim(frame_id)) {
-        return false; // All frames are pinned, can't evict.
+    // The ring is still filling up
+    if (!AcquireFrame(frame_id, may_wait)) {
+        return false;
     }
-    
-    // We have a victim frame, need to evict it
-    Page *victim_page = &pages_[*frame_id];
-    page_id_t victim_page_id = victim_page->GetPageId();
+    ring->entries_.push_back(ScanRing::Entry{*frame_id, page_id});
+    return true;
+}
 
-    // If victim page is dirty flush it to disk
-    FlushPage(victim_page_id); 
+bool BufferPoolManager::AcquireFrame(frame_id_t *frame_id, bool may_wait) {
+    while (true) {
+        // Check if there's a free frame
+        if (TakeFreeFrame(frame_id)) {
+            return true;
+        }
 
-    // Remove victim page from the page table
-    page_table_.erase(victim_page_id);
+        // Frames of finished read-ahead become evictable
+        if (may_wait) {
+            ReapReads(false);
+        }
+
+        // No free frames, try to evict a frame using the replacer
+        frame_id_t victim;
+        if (replacer_->Victim(&victim)) {
+            if (EvictFrame(victim)) {
+                if (static_cast<size_t>(victim) >= pool_size_.load()) {
+                    ReturnFrame(victim); // Out of service since a shrink: retire it
+                    continue;
+                }
+                *frame_id = victim;
+                return true;
+            }
+            continue; // Pinned or reused since it was queued; try the next one
+        }
 
+        // Everything is pinned; reads in flight will release frames, so wait for them as a last resort
+        bool reads_pending;
+        {
+            std::lock_guard<std::mutex> lock(pending_latch_);
+            reads_pending = !pending_reads_.empty();
+        }
+        if (!may_wait || !reads_pending) {
+            return false; // All frames are pinned, can't evict.
+        }
+        counters_.Add(FRAME_WAITS);
+        ReapReads(true);
+    }
+}
+
+bool BufferPoolManager::EvictFrame(frame_id_t frame_id) {
+    FrameHeader &frame = Frame(frame_id);
+    page_id_t victim_page_id = frame.page_id.load();
+    if (victim_page_id == INVALID_PAGE_ID) {
+        return false;
+    }
+
+    PageTableShard &shard = ShardFor(victim_page_id);
+    std::lock_guard<std::mutex> lock(shard.latch);
+    if (shard.page_table.Find(victim_page_id) != frame_id || frame.state.load() != FrameState::READY) {
+        return false; // Whoever owns it now will requeue it when they unpin
+    }
+    // A write-back in flight is about to make the frame clean; let it land first
+    WaitForWriteBack(frame);
+    if (!ClaimFrame(frame)) {
+        return false; // Whoever pins it now will requeue it when they unpin
+    }
+
+    // If victim page is dirty flush it to disk. The shard stays latched so no one
+    // can fetch the page and read stale data from disk meanwhile. The background
+    // writer normally got there first; if not, nudge it.
+    if (frame.is_dirty.load()) {
+        try {
+            StampPageChecksum(FramePage(frame_id)->GetData());
+            disk_manager_->WritePage(victim_page_id, FramePage(frame_id)->GetData());
+        } catch (...) {
+            frame.pin_count = 0;
+            replacer_->Unpin(frame_id); // Still resident and evictable
+            throw;
+        }
+        counters_.Add(EVICTION_WRITES);
+        {
+            std::lock_guard<std::mutex> wake_lock(bg_writer_latch_);
+            bg_writer_wake_ = true;
+        }
+        bg_writer_cv_.notify_one();
+    }
+
+    // Remove victim page from the page table; the frame stays claimed for its next owner
+    shard.page_table.Erase(victim_page_id);
+    replacer_->Remove(frame_id);
+    frame.page_id = INVALID_PAGE_ID;
+    frame.is_dirty = false;
+    frame.state = FrameState::FREE;
+    counters_.Add(EVICTIONS);
     return true;
 }
 
+void BufferPoolManager::ReturnFrame(frame_id_t frame_id) {
+    FrameHeader &frame = Frame(frame_id);
+    frame.page_id = INVALID_PAGE_ID;
+    frame.is_dirty = false;
+
+    // Decided under the free list latch, which Resize holds while it moves pool_size_
+    std::lock_guard<std::mutex> lock(free_list_latch_);
+    if (static_cast<size_t>(frame_id) >= pool_size_.load()) {
+        frame.state = FrameState::RETIRED; // Out of service since a shrink
+        return;
+    }
+    frame.state = FrameState::FREE;
+    free_list_.push_back(frame_id);
+}
+
+void BufferPoolManager::WaitForFrame(frame_id_t frame_id) {
+    FrameHeader &frame = Frame(frame_id);
+    if (frame.state.load() != FrameState::LOADING) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(frame.latch);
+    frame.cv.wait(lock, [&frame] { return frame.state.load() != FrameState::LOADING; });
+}
+
+void BufferPoolManager::FinishLoad(frame_id_t frame_id) {
+    FrameHeader &frame = Frame(frame_id);
+    {
+        std::lock_guard<std::mutex> lock(frame.latch);
+        frame.state = FrameState::READY;
+    }
+    frame.cv.notify_all();
+}
+
+void BufferPoolManager::FailLoad(frame_id_t frame_id) {
+    FrameHeader &frame = Frame(frame_id);
+    bool claimed;
+    {
+        PageTableShard &shard = ShardFor(frame.page_id.load());
+        std::lock_guard<std::mutex> lock(shard.latch);
+        shard.page_table.Erase(frame.page_id.load());
+        frame.pending_read = nullptr;
+        {
+            std::lock_guard<std::mutex> frame_lock(frame.latch);
+            frame.state = FrameState::FAILED;
+        }
+        // FAILED is visible first, so if this misses a pin, that pin's release sees FAILED
+        claimed = ClaimFrame(frame);
+    }
+    frame.cv.notify_all();
+
+    // With pins held, the last release frees the frame (see ReleaseFailedPin)
+    if (claimed) {
+        ReturnFrame(frame_id);
+    }
+}
+
+void BufferPoolManager::ReleaseFailedPin(frame_id_t frame_id) {
+    FrameHeader &frame = Frame(frame_id);
+    if (frame.pin_count.fetch_sub(1) == 1 && ClaimFrame(frame)) {
+        ReturnFrame(frame_id);
+    }
+}
+
+bool BufferPoolManager::TryPinResident(PageTableShard &shard, page_id_t page_id, frame_id_t *frame_id) {
+    frame_id_t found = shard.page_table.Find(page_id);
+    if (found == PageTable::NO_FRAME) {
+        return false;
+    }
+
+    FrameHeader &frame = Frame(found);
+    int32_t pins = frame.pin_count.load();
+    do {
+        if (pins < 0) {
+            return false; // Claimed: being evicted or deleted
+        }
+    } while (!frame.pin_count.compare_exchange_weak(pins, pins + 1));
+
+    // Pinned, so the frame can't change pages any more: this check is stable
+    if (frame.page_id.load() != page_id || frame.state.load() != FrameState::READY) {
+        ReleaseSpeculativePin(found);
+        return false;
+    }
+    if (pins == 0) {
+        replacer_->Pin(found);
+    }
+    *frame_id = found;
+    return true;
+}
+
+void BufferPoolManager::ReleaseSpeculativePin(frame_id_t frame_id) {
+    FrameHeader &frame = Frame(frame_id);
+    if (frame.pin_count.fetch_sub(1) != 1) {
+        return;
+    }
+    // Ours was the last pin, so do what the frame's last unpin would have done
+    FrameState state = frame.state.load();
+    if (state == FrameState::READY) {
+        replacer_->Unpin(frame_id);
+    } else if (state == FrameState::FAILED && ClaimFrame(frame)) {
+        ReturnFrame(frame_id);
+    }
+}
+
+frame_id_t BufferPoolManager::LookupPinnedFrame(PageTableShard &shard, page_id_t page_id) {
+    frame_id_t frame_id = shard.page_table.Find(page_id);
+    if (frame_id != PageTable::NO_FRAME && Frame(frame_id).page_id.load() == page_id) {
+        return frame_id;
+    }
+    // Absent, or missed while a writer was moving entries
+    std::lock_guard<std::mutex> lock(shard.latch);
+    return shard.page_table.Find(page_id);
+}
+
 Page *BufferPoolManager::FetchPage(page_id_t page_id) {
+    frame_id_t frame_id;
+    return FetchFrame(page_id, &frame_id);
+}
+
+Page *BufferPoolManager::FetchFrame(page_id_t page_id, frame_id_t *out_frame_id, ScanRing *ring) {
+    *out_frame_id = PageTable::NO_FRAME;
     if (page_id == INVALID_PAGE_ID) {
           return nullptr;  // Can't fetch invalid page
     }
 
-    // Check if page is already in buffer pool
-    if (page_table_.find(page_id) != page_table_.end()) {
-        // Page hit! Get the frame it's in 
-        frame_id_t frame_id = page_table_[page_id];
-        Page *page = &pages_[frame_id];
+    // Read-only mapped file: the page lives in the mapping, no frame or pinning needed.
+    // Page is a plain PAGE_SIZE byte array, so the mapping has the same layout as a frame.
+    if (disk_manager_->IsReadOnlyMapped()) {
+        if (page_id < 0 || page_id >= disk_manager_->GetNumPages()) {
+            return nullptr; // Not in the mapping: report it like any page that can't be fetched
+        }
+        const char *data = disk_manager_->GetMappedPage(page_id);
+
+        // Verified the first time it is handed out, as a page loaded into a frame would be
+        std::atomic<uint64_t> &verified = mapped_verified_[page_id / 64];
+        uint64_t bit = uint64_t{1} << (page_id % 64);
+        if ((verified.load(std::memory_order_relaxed) & bit) == 0) {
+            if (!VerifyPageChecksum(data)) {
+                throw std::runtime_error("Page checksum mismatch on page " + std::to_string(page_id));
+            }
+            verified.fetch_or(bit, std::memory_order_relaxed);
+        }
+        counters_.Add(HITS);
+        return reinterpret_cast<Page *>(const_cast<char *>(data));
+    }
+
+    // Hit on a loaded page: no latch
+    PageTableShard &shard = ShardFor(page_id);
+    frame_id_t frame_id;
+    if (TryPinResident(shard, page_id, &frame_id)) {
+        counters_.Add(HITS);
+        replacer_->RecordAccess(frame_id, page_id);
+        NoteFetch(page_id, ring);
+        *out_frame_id = frame_id;
+        return FramePage(frame_id);
+    }
+
+    while (true) {
+        std::unique_lock<std::mutex> lock(shard.latch);
+
+        // Check if page is already in buffer pool (possibly still loading)
+        frame_id = shard.page_table.Find(page_id);
+        if (frame_id != PageTable::NO_FRAME) {
+            // Page hit! Get the frame it's in
+            FrameHeader &frame = Frame(frame_id);
+
+            // Increment pin count; if this is the first pin, remove from replacer
+            if (frame.pin_count.fetch_add(1) == 0) {
+                replacer_->Pin(frame_id);
+            }
+            std::shared_ptr<PendingRead> read = frame.pending_read;
+            lock.unlock();
+
+            // A read of this page may still be in flight; finish it (or wait for whoever is) first
+            if (read != nullptr || frame.state.load() == FrameState::LOADING) {
+                counters_.Add(PIN_WAITS);
+            }
+            if (read != nullptr) {
+                CompleteRead(read);
+            }
+            WaitForFrame(frame_id);
+            if (frame.state.load() == FrameState::FAILED) {
+                ReleaseFailedPin(frame_id);
+                continue; // Read it ourselves; reports the error if it persists
+            }
+
+            counters_.Add(HITS);
+            replacer_->RecordAccess(frame_id, page_id);
+            NoteFetch(page_id, ring);
+            *out_frame_id = frame_id;
+            return FramePage(frame_id);
+        }
+        lock.unlock();
+
+        // Page not in buffer. Frames are found without the shard latch: eviction may write.
+        bool acquired = ring != nullptr ? AcquireRingFrame(ring, page_id, &frame_id, true) : AcquireFrame(&frame_id, true);
+        if (!acquired) {
+            counters_.Add(NO_FRAME);
+            return nullptr; // No frames available, can't load page.
+        }
+
+        lock.lock();
+        if (shard.page_table.Find(page_id) != PageTable::NO_FRAME) {
+            // Someone else loaded it meanwhile; use theirs
+            lock.unlock();
+            ReturnFrame(frame_id);
+            continue;
+        }
+
+        // Publish the frame as loading so other fetches of this page wait for us
+        FrameHeader &frame = Frame(frame_id);
+        frame.page_id = page_id;
+        frame.is_dirty = false;
+        frame.pin_count = 1;
+        frame.state = FrameState::LOADING;
+        shard.page_table.Insert(page_id, frame_id);
+        lock.unlock();
 
-        // Increment pin count and return the page
-        pin_count_[frame_id]++;
+        // Load page from disk into the frame, with no latch held
+        counters_.Add(MISSES);
+        Page *page = FramePage(frame_id);
+        try {
+            disk_manager_->ReadPage(page_id, page->GetData());
+        } catch (...) {
+            FailLoad(frame_id); // Don't lose the frame
+            ReleaseFailedPin(frame_id);
+            throw;
+        }
 
-        // If this is the first pin, remove from replacer
-        if (pin_count_[frame_id] == 1) {
-            replacer_->Pin(frame_id);
+        // Detect torn or corrupted pages before anyone uses them
+        if (!VerifyPageChecksum(page->GetData())) {
+            FailLoad(frame_id);
+            ReleaseFailedPin(frame_id);
+            throw std::runtime_error("Page checksum mismatch on page " + std::to_string(page_id));
         }
 
+        FinishLoad(frame_id);
+        replacer_->RecordAccess(frame_id, page_id);
+        NoteFetch(page_id, ring);
+        *out_frame_id = frame_id;
         return page;
     }
+}
 
-    // Page not in buffer
-    frame_id_t frame_id;
-    if (!FindVictimFrame(&frame_id)) {
-        return nullptr; // No frames available, can't load page.
+void BufferPoolManager::CompleteRead(const std::shared_ptr<PendingRead> &read) {
+    std::lock_guard<std::mutex> read_lock(read->latch);
+    if (read->completed) {
+        return; // Another thread got here first
     }
 
-    // Load page from disk into the frame
-    Page *page = &pages_[frame_id];
-    disk_manager_->ReadPage(page_id, page->GetData());
-    
-    // Update buffer pool metadata
-    page_table_[page_id] = frame_id; // Map page to frame
-    pin_count_[frame_id] = 1; // Increment pin count and return the page
-    is_dirty_[frame_id] = false; // Not dirty yet
+    bool succeeded = read->batch != nullptr;
+    if (succeeded) {
+        try {
+            disk_manager_->WaitForBatch(read->batch);
+        } catch (const std::runtime_error &) {
+            succeeded = false; // Read-ahead is advisory; a later FetchPage reports the error
+        }
+    }
 
-    // Frame is pinned, so remove from replacer
-    replacer_->Pin(frame_id);
+    for (frame_id_t frame_id : read->frames) {
+        FrameHeader &frame = Frame(frame_id);
+        if (succeeded && VerifyPageChecksum(FramePage(frame_id)->GetData())) {
+            {
+                PageTableShard &shard = ShardFor(frame.page_id.load());
+                std::lock_guard<std::mutex> lock(shard.latch);
+                frame.pending_read = nullptr;
+                {
+                    std::lock_guard<std::mutex> frame_lock(frame.latch);
+                    frame.state = FrameState::READY;
+                }
+                // Resident and unpinned: evictable until someone fetches it
+                if (frame.pin_count.load() == 0) {
+                    replacer_->Unpin(frame_id);
+                }
+            }
+            frame.cv.notify_all();
+        } else {
+            FailLoad(frame_id);
+        }
+    }
 
-    return page;
+    read->completed = true;
+    std::lock_guard<std::mutex> lock(pending_latch_);
+    pending_reads_.remove(read);
+}
+
+void BufferPoolManager::ReapReads(bool wait) {
+    std::vector<std::shared_ptr<PendingRead>> reads;
+    {
+        std::lock_guard<std::mutex> lock(pending_latch_);
+        for (const auto &read : pending_reads_) {
+            if (wait || (read->batch != nullptr && read->batch->IsComplete())) {
+                reads.push_back(read);
+            }
+        }
+    }
+    // CompleteRead removes each from the list
+    for (const auto &read : reads) {
+        CompleteRead(read);
+    }
+}
+
+std::unique_ptr<ScanRing> BufferPoolManager::NewScanRing(size_t num_frames) {
+    if (num_frames == 0) {
+        throw std::invalid_argument("A scan ring needs at least one frame");
+    }
+    return std::unique_ptr<ScanRing>(new ScanRing(num_frames));
+}
+
+size_t BufferPoolManager::Prefetch(page_id_t page_id, size_t num_pages) {
+    return PrefetchRange(page_id, num_pages, nullptr);
+}
+
+size_t BufferPoolManager::PrefetchRange(page_id_t page_id, size_t num_pages, ScanRing *ring) {
+    if (disk_manager_->IsReadOnlyMapped() || num_pages == 0 || page_id < 0) {
+        return 0;
+    }
+
+    // Frames of finished reads become evictable before we look for room
+    ReapReads(false);
+
+    page_id_t end = std::min(page_id + static_cast<page_id_t>(num_pages), disk_manager_->GetNumPages());
+    std::vector<page_id_t> page_ids;
+    for (page_id_t prefetch_page_id = page_id; prefetch_page_id < end; prefetch_page_id++) {
+        page_ids.push_back(prefetch_page_id);
+    }
+    return StartReads(page_ids.data(), page_ids.size(), true, ring);
+}
+
+size_t BufferPoolManager::StartReads(const page_id_t *page_ids, size_t num_pages, bool may_evict, ScanRing *ring) {
+    auto read = std::make_shared<PendingRead>();
+    std::vector<PageRequest> requests;
+
+    // Fetches that find one of these frames wait on this latch until the read is submitted
+    std::unique_lock<std::mutex> read_lock(read->latch);
+
+    for (size_t i = 0; i < num_pages; i++) {
+        page_id_t prefetch_page_id = page_ids[i];
+        if (!OwnsPage(prefetch_page_id)) {
+            continue; // Another instance's page
+        }
+        PageTableShard &shard = ShardFor(prefetch_page_id);
+        {
+            std::lock_guard<std::mutex> lock(shard.latch);
+            if (shard.page_table.Find(prefetch_page_id) != PageTable::NO_FRAME) {
+                continue;
+            }
+        }
+        // Never wait for other reads to make room for a speculative one
+        frame_id_t frame_id;
+        bool acquired = ring != nullptr ? AcquireRingFrame(ring, prefetch_page_id, &frame_id, false)
+                        : may_evict ? AcquireFrame(&frame_id, false) : TakeFreeFrame(&frame_id);
+        if (!acquired) {
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(shard.latch);
+        if (shard.page_table.Find(prefetch_page_id) != PageTable::NO_FRAME) {
+            ReturnFrame(frame_id);
+            continue;
+        }
+
+        // Reserved for the read: not pinned, but not evictable either until it completes
+        FrameHeader &frame = Frame(frame_id);
+        frame.page_id = prefetch_page_id;
+        frame.is_dirty = false;
+        frame.pin_count = 0;
+        frame.state = FrameState::LOADING;
+        frame.pending_read = read;
+        shard.page_table.Insert(prefetch_page_id, frame_id);
+        read->frames.push_back(frame_id);
+        requests.push_back(PageRequest{prefetch_page_id, FramePage(frame_id)->GetData()});
+    }
+
+    if (requests.empty()) {
+        return 0;
+    }
+    counters_.Add(PREFETCHED, requests.size());
+
+    try {
+        read->batch = disk_manager_->SubmitReadPages(requests);
+    } catch (const std::exception &) {
+        read->batch = nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pending_latch_);
+        pending_reads_.push_back(read);
+    }
+    read_lock.unlock();
+
+    if (read->batch == nullptr) {
+        CompleteRead(read); // Unmaps the frames and frees them
+        return 0;
+    }
+    return requests.size();
+}
+
+void BufferPoolManager::HintSequential(page_id_t page_id, ScanRing *ring) {
+    // A ring scan reads ahead into its ring: at most half of it, so reads ahead never
+    // recycle frames the scan has yet to get to
+    size_t window = read_ahead_window_;
+    if (ring != nullptr) {
+        window = std::min(window, ring->num_frames_ / 2);
+    }
+    if (window == 0 || page_id == INVALID_PAGE_ID) {
+        return;
+    }
+    {
+        // As if the scan had already fetched READ_AHEAD_TRIGGER pages in a row
+        std::lock_guard<std::mutex> lock(read_ahead_latch_);
+        last_fetched_page_id_ = page_id - static_cast<page_id_t>(num_partitions_);
+        sequential_run_ = READ_AHEAD_TRIGGER - 1;
+        read_ahead_end_ = page_id + static_cast<page_id_t>(window);
+    }
+    PrefetchRange(page_id, window, ring);
+}
+
+void BufferPoolManager::NoteFetch(page_id_t page_id, ScanRing *ring) {
+    size_t window_size = read_ahead_window_;
+    if (ring != nullptr) {
+        window_size = std::min(window_size, ring->num_frames_ / 2); // See HintSequential
+    }
+    if (window_size == 0) {
+        return;
+    }
+
+    page_id_t start;
+    page_id_t end;
+    {
+        std::lock_guard<std::mutex> lock(read_ahead_latch_);
+        if (page_id == last_fetched_page_id_) {
+            return; // Repeated fetches of one page (e.g. per tuple) don't count
+        }
+
+        // In a partition, the next page of a scan is num_partitions_ ids on
+        page_id_t stride = static_cast<page_id_t>(num_partitions_);
+        if (last_fetched_page_id_ != INVALID_PAGE_ID && page_id == last_fetched_page_id_ + stride) {
+            sequential_run_++;
+        } else {
+            sequential_run_ = 1;
+        }
+        last_fetched_page_id_ = page_id;
+        if (sequential_run_ < READ_AHEAD_TRIGGER) {
+            return;
+        }
+
+        // Top the window up once half of it has been consumed
+        page_id_t window = static_cast<page_id_t>(window_size);
+        if (read_ahead_end_ < page_id + 1 || read_ahead_end_ > page_id + 1 + window) {
+            read_ahead_end_ = page_id + 1; // Window belongs to an earlier run
+        }
+        if (read_ahead_end_ - (page_id + 1) > window / 2) {
+            return;
+        }
+
+        start = read_ahead_end_;
+        end = page_id + 1 + window;
+        read_ahead_end_ = end;
+    }
+    // Issued unlatched so concurrent fetches don't wait behind the submission
+    PrefetchRange(start, static_cast<size_t>(end - start), ring);
 }
 
 bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
-    // Check if page is in buffer pool
-    if (page_table_.find(page_id) == page_table_.end()) {
-        return false;
+    // Mapped pages are never pinned; they cannot be dirty either
+    if (disk_manager_->IsReadOnlyMapped()) {
+        return !is_dirty;
     }
 
-    frame_id_t frame_id = page_table_[page_id];
+    // Check if page is in buffer pool; the caller's pin keeps it there
+    frame_id_t frame_id = LookupPinnedFrame(ShardFor(page_id), page_id);
+    if (frame_id == PageTable::NO_FRAME) {
+        return false;
+    }
+    FrameHeader &frame = Frame(frame_id);
 
     // Check if page is already pinned
-    if (pin_count_[frame_id] == 0) {
+    int32_t pins = frame.pin_count.load();
+    if (pins <= 0) {
         return false;
     }
 
-    // Decrement pin count
-    pin_count_[frame_id]--;
-
-    // Mark dirty if requested
+    // Mark dirty if requested, while our pin still keeps it from being evicted
     if (is_dirty) {
-        is_dirty_[frame_id] = true;
+        frame.is_dirty = true;
     }
 
-    // If pin count reaches 0, add to replacer
-    if (pin_count_[frame_id] == 0) {
+    // Decrement pin count; if it reaches 0, add to replacer
+    while (!frame.pin_count.compare_exchange_weak(pins, pins - 1)) {
+        if (pins <= 0) {
+            return false;
+        }
+    }
+    if (pins == 1) {
         replacer_->Unpin(frame_id);
     }
 
@@ -150,83 +799,630 @@ bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
 }
 
 bool BufferPoolManager::FlushPage(page_id_t page_id) {
+    std::lock_guard<std::mutex> flush_lock(flush_latch_);
+
     // Check if page is in buffer pool
-    if (page_table_.find(page_id) == page_table_.end()) {
-        return false; // Page not in buffer pool, can't flush
-    } 
+    PageTableShard &shard = ShardFor(page_id);
+    frame_id_t frame_id;
+    {
+        std::lock_guard<std::mutex> lock(shard.latch);
+        frame_id = shard.page_table.Find(page_id);
+        if (frame_id == PageTable::NO_FRAME) {
+            return false; // Page not in buffer pool, can't flush
+        }
 
-    frame_id_t frame_id = page_table_[page_id];
+        // A page still loading has never been modified
+        FrameHeader &frame = Frame(frame_id);
+        if (frame.state.load() != FrameState::READY) {
+            return true;
+        }
+        if (!frame.is_dirty.load() && !frame.writing_back.load()) {
+            return true;
+        }
 
-    if (!is_dirty_[frame_id]) {
-        return true;
+        // The pin keeps the page in its frame once the shard latch is dropped, which
+        // it must be before waiting for a write guard to let go of the page
+        PinForFlush(frame_id);
     }
 
-    Page *page = &pages_[frame_id];
-    disk_manager_->WritePage(page_id, page->GetData());
-
-    is_dirty_[frame_id] = false;
+    // A background write of the page finishes first, so ours is the last
+    WaitForWriteBack(Frame(frame_id));
+    std::unique_ptr<char[]> buffer(new char[PAGE_SIZE]);
+    if (CopyDirtyPage(frame_id, buffer.get())) {
+        try {
+            StampPageChecksum(buffer.get());
+            disk_manager_->WritePage(page_id, buffer.get());
+        } catch (...) {
+            Frame(frame_id).is_dirty = true;
+            UnpinAfterFlush(frame_id);
+            throw;
+        }
+        counters_.Add(FLUSH_WRITES);
+    }
+    UnpinAfterFlush(frame_id);
 
     return true;
 }
 
+ReadPageGuard BufferPoolManager::FetchPageRead(page_id_t page_id) {
+    return FetchPageRead(page_id, nullptr);
+}
+
+ReadPageGuard BufferPoolManager::FetchPageRead(page_id_t page_id, ScanRing *ring) {
+    frame_id_t frame_id;
+    Page *page = FetchFrame(page_id, &frame_id, ring);
+    if (page == nullptr) {
+        return ReadPageGuard();
+    }
+    // Mapped pages are read-only and not in a frame: nothing to latch
+    if (disk_manager_->IsReadOnlyMapped()) {
+        return ReadPageGuard(this, page_id, page, nullptr);
+    }
+
+    std::shared_mutex &latch = Frame(frame_id).rwlatch;
+    latch.lock_shared();
+    return ReadPageGuard(this, page_id, page, &latch);
+}
+
+WritePageGuard BufferPoolManager::FetchPageWrite(page_id_t page_id) {
+    if (disk_manager_->IsReadOnlyMapped()) {
+        return WritePageGuard(); // Read-only file
+    }
+    frame_id_t frame_id;
+    Page *page = FetchFrame(page_id, &frame_id);
+    if (page == nullptr) {
+        return WritePageGuard();
+    }
+
+    std::shared_mutex &latch = Frame(frame_id).rwlatch;
+    latch.lock();
+    return WritePageGuard(this, page_id, page, &latch, false);
+}
+
+WritePageGuard BufferPoolManager::NewPageGuarded(page_id_t *page_id, PageExtent *extent) {
+    Page *page = NewPage(page_id, extent);
+    if (page == nullptr) {
+        return WritePageGuard();
+    }
+    return GuardNewPage(*page_id, page);
+}
+
+WritePageGuard BufferPoolManager::GuardNewPage(page_id_t page_id, Page *page) {
+    // Nobody else holds a page that was just created, so this doesn't wait
+    std::shared_mutex &latch = Frame(LookupPinnedFrame(ShardFor(page_id), page_id)).rwlatch;
+    latch.lock();
+    return WritePageGuard(this, page_id, page, &latch, true);
+}
+
 Page *BufferPoolManager::NewPage(page_id_t *page_id) {
+    return NewPage(page_id, nullptr);
+}
+
+Page *BufferPoolManager::NewPage(page_id_t *page_id, PageExtent *extent) {
+    if (disk_manager_->IsReadOnlyMapped()) {
+        return nullptr; // Read-only file
+    }
+
     // Find a victim frame
     frame_id_t frame_id;
-    if (!FindVictimFrame(&frame_id)) {
+    if (!AcquireFrame(&frame_id, true)) {
+        counters_.Add(NO_FRAME);
         return nullptr;
     }
 
     // Allocate a new page id from disk manager
-    page_id_t new_page_id = disk_manager_->AllocatePage();
+    page_id_t new_page_id;
+    try {
+        new_page_id = extent != nullptr ? disk_manager_->AllocatePage(extent) : disk_manager_->AllocatePage();
+    } catch (...) {
+        ReturnFrame(frame_id);
+        throw;
+    }
 
-    // Initialize the new page (make it empty)
-    Page *page = &pages_[frame_id];
-    page->Init(new_page_id);
+    // Return the new page_id to caller
+    *page_id = new_page_id;
 
-    // Update buffer pool metadata
-    page_table_[new_page_id] = frame_id;
-    pin_count_[frame_id] = 1;
-    is_dirty_[frame_id] = true;
+    return InstallNewPage(frame_id, new_page_id);
+}
 
-    // Frame is pinned, so remove from replacer
-    replacer_->Pin(frame_id);
+void BufferPoolManager::ReleaseExtent(PageExtent *extent) {
+    disk_manager_->ReleaseExtent(extent);
+}
 
-    // Return the new page_id to caller
-    *page_id = new_page_id;
+Page *BufferPoolManager::NewPageWithId(page_id_t page_id) {
+    frame_id_t frame_id;
+    if (!AcquireFrame(&frame_id, true)) {
+        counters_.Add(NO_FRAME);
+        return nullptr;
+    }
+    return InstallNewPage(frame_id, page_id);
+}
+
+Page *BufferPoolManager::InstallNewPage(frame_id_t frame_id, page_id_t new_page_id) {
+    // Initialize the new page (make it empty)
+    Page *page = FramePage(frame_id);
+    page->Init(new_page_id);
+
+    // Update buffer pool metadata; the frame came from AcquireFrame, so it is not in the replacer.
+    // Extents are allocated ahead of use, so read-ahead may already hold a (zero) copy of the
+    // page; that copy is dropped first, and again if another read-ahead races us to it.
+    FrameHeader &frame = Frame(frame_id);
+    PageTableShard &shard = ShardFor(new_page_id);
+    while (true) {
+        if (!DiscardPage(new_page_id)) {
+            ReturnFrame(frame_id);
+            throw std::logic_error("New page " + std::to_string(new_page_id) + " is pinned by an earlier fetch");
+        }
+        std::lock_guard<std::mutex> lock(shard.latch);
+        if (shard.page_table.Find(new_page_id) != PageTable::NO_FRAME) {
+            continue;
+        }
+        frame.page_id = new_page_id;
+        frame.pin_count = 1;
+        frame.is_dirty = true;
+        frame.state = FrameState::READY;
+        shard.page_table.Insert(new_page_id, frame_id);
+        break;
+    }
+    replacer_->RecordAccess(frame_id, new_page_id);
+    counters_.Add(PAGES_CREATED);
 
     return page;
 }
 
-bool BufferPoolManager::DeletePage(page_id_t page_id) {
-    // Check if page is in buffer pool
-    auto it = page_table_.find(page_id);
+bool BufferPoolManager::DiscardPage(page_id_t page_id) {
+    PageTableShard &shard = ShardFor(page_id);
+    while (true) {
+        std::unique_lock<std::mutex> lock(shard.latch);
+
+        // Check if page is in buffer pool
+        frame_id_t frame_id = shard.page_table.Find(page_id);
+        if (frame_id == PageTable::NO_FRAME) {
+            return true;
+        }
 
-    if (it != page_table_.end()) {
         // Page is in buffer pool
-        frame_id_t frame_id = it->second;
+        FrameHeader &frame = Frame(frame_id);
 
         // Check if page is pinned
-        if (pin_count_[frame_id] > 0) {
-            return false; // Page is pinned, can't delete
+        if (frame.pin_count.load() > 0) {
+            return false;
         }
 
-        // Remove from replacer (if it's there)
-        replacer_->Pin(frame_id);
+        // Unpinned but loading: a read-ahead; let it land, then look again
+        if (frame.state.load() == FrameState::LOADING) {
+            std::shared_ptr<PendingRead> read = frame.pending_read;
+            lock.unlock();
+            if (read != nullptr) {
+                CompleteRead(read);
+            } else {
+                WaitForFrame(frame_id);
+            }
+            continue;
+        }
+
+        // Claim it, unless a lock-free fetch has just pinned it. A write-back of
+        // the page must land before the page can be deleted or recreated.
+        WaitForWriteBack(frame);
+        if (!ClaimFrame(frame)) {
+            return false;
+        }
+
+        // Remove from replacer (if it's there), history included
+        replacer_->Remove(frame_id);
 
         // Remove from page table
-        page_table_.erase(page_id);
+        shard.page_table.Erase(page_id);
+        lock.unlock();
 
-        // Reset from metadata
-        is_dirty_[frame_id] = false;
+        // Reset the metadata and add back to free list
+        ReturnFrame(frame_id);
+        return true;
+    }
+}
 
-        // Add from back to free list
-        free_list_.push_back(frame_id);
+bool BufferPoolManager::DeletePage(page_id_t page_id) {
+    if (disk_manager_->IsReadOnlyMapped()) {
+        return false; // Read-only file
+    }
+
+    if (!DiscardPage(page_id)) {
+        return false; // Page is pinned, can't delete
     }
 
     // Tell DiskManager to deallocate the page
     disk_manager_->DeallocatePage(page_id);
+    counters_.Add(PAGES_DELETED);
 
     return true;
 }
 
+void BufferPoolManager::BackgroundWriterLoop() {
+    std::unique_ptr<char[]> buffer(new char[PAGE_SIZE]);
+    std::vector<frame_id_t> candidates;
+    auto last_round = std::chrono::steady_clock::now();
+    double tokens = 0; // Pages the rate limit allows right now
+
+    std::unique_lock<std::mutex> lock(bg_writer_latch_);
+    while (true) {
+        bg_writer_cv_.wait_for(lock, std::chrono::milliseconds(BG_WRITER_INTERVAL_MS),
+                               [this] { return bg_writer_stop_ || bg_writer_wake_; });
+        if (bg_writer_stop_) {
+            return;
+        }
+        bg_writer_wake_ = false;
+        lock.unlock();
+
+        // Token bucket holding at most one interval's worth of writes
+        auto now = std::chrono::steady_clock::now();
+        double rate = static_cast<double>(bg_writer_rate_.load());
+        double elapsed = std::chrono::duration<double>(now - last_round).count();
+        double burst = std::max(1.0, rate * BG_WRITER_INTERVAL_MS / 1000);
+        tokens = std::min(burst, tokens + rate * elapsed);
+        last_round = now;
+
+        // Evict the frames a shrink left pinned, once they are unpinned
+        if (num_frames_.load() > pool_size_.load()) {
+            std::lock_guard<std::mutex> resize_lock(resize_latch_);
+            DrainFrames();
+        }
+
+        // Clean the dirty pages among the frames the replacer will evict next
+        size_t window = static_cast<size_t>(replacer_->Size() * BG_WRITER_CLEAN_TARGET + 0.5);
+        candidates.resize(std::min(window, num_frames_.load()));
+        size_t num_candidates = replacer_->NextVictims(candidates.data(), candidates.size());
+        for (size_t i = 0; i < num_candidates && tokens >= 1; i++) {
+            if (CleanFrame(candidates[i], buffer.get())) {
+                tokens -= 1;
+            }
+        }
+
+        lock.lock();
+    }
+}
+
+bool BufferPoolManager::CleanFrame(frame_id_t frame_id, char *buffer) {
+    FrameHeader &frame = Frame(frame_id);
+    page_id_t page_id = frame.page_id.load();
+    if (page_id == INVALID_PAGE_ID || !frame.is_dirty.load()) {
+        return false;
+    }
+
+    // Copy the page under the shard latch, so it can't be evicted or reloaded meanwhile.
+    // Pinned pages are in use and not about to be evicted; they are left alone.
+    PageTableShard &shard = ShardFor(page_id);
+    {
+        std::lock_guard<std::mutex> lock(shard.latch);
+        if (shard.page_table.Find(page_id) != frame_id || frame.state.load() != FrameState::READY ||
+            frame.pin_count.load() != 0 || !frame.is_dirty.load()) {
+            return false;
+        }
+        if (!frame.rwlatch.try_lock_shared()) {
+            return false; // A write guard is mid-update; next round
+        }
+        std::memcpy(buffer, FramePage(frame_id)->GetData(), PAGE_SIZE);
+        // Cleared while the shared latch still keeps writers out: the hit path pins without the
+        // shard latch, so a change made after the unlock must find the bit clear and set it again.
+        // Eviction, flushes and deletion wait for writing_back to drop.
+        frame.is_dirty = false;
+        frame.writing_back = true;
+        frame.rwlatch.unlock_shared();
+    }
+
+    // The write runs unlatched, so fetches and unpins of the page don't wait for it
+    bool written = true;
+    try {
+        StampPageChecksum(buffer);
+        disk_manager_->WritePage(page_id, buffer);
+    } catch (const std::exception &) {
+        frame.is_dirty = true; // Eviction will write it (and report the error)
+        written = false;
+    }
+    {
+        std::lock_guard<std::mutex> frame_lock(frame.latch);
+        frame.writing_back = false;
+    }
+    frame.cv.notify_all();
+
+    if (written) {
+        counters_.Add(BACKGROUND_WRITES);
+    }
+    return written;
+}
+
+void BufferPoolManager::WaitForWriteBack(FrameHeader &frame) {
+    if (!frame.writing_back.load()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(frame.latch);
+    frame.cv.wait(lock, [&frame] { return !frame.writing_back.load(); });
+}
+
+size_t BufferPoolManager::EnableWarmup() {
+    if (disk_manager_->IsReadOnlyMapped()) {
+        return 0; // Pages are never copied into frames
+    }
+    std::string file_name = WarmupFileName(disk_manager_->GetFileName());
+    {
+        std::lock_guard<std::mutex> lock(warmup_latch_);
+        warmup_file_ = file_name;
+    }
+    return WarmUp(ReadWarmupList(file_name));
+}
+
+std::vector<page_id_t> BufferPoolManager::GetHotPages() {
+    std::vector<page_id_t> page_ids;
+    size_t num_frames = num_frames_.load();
+
+    // Pinned pages are in use right now: hottest of all
+    for (size_t i = 0; i < num_frames; i++) {
+        FrameHeader &frame = Frame(static_cast<frame_id_t>(i));
+        page_id_t page_id = frame.page_id.load();
+        if (page_id != INVALID_PAGE_ID && frame.pin_count.load() > 0 && frame.state.load() == FrameState::READY) {
+            page_ids.push_back(page_id);
+        }
+    }
+
+    // Then the unpinned ones, last to be evicted first
+    std::vector<frame_id_t> victims(num_frames);
+    size_t count = replacer_->NextVictims(victims.data(), victims.size());
+    for (size_t i = count; i-- > 0;) {
+        page_id_t page_id = Frame(victims[i]).page_id.load();
+        if (page_id != INVALID_PAGE_ID) {
+            page_ids.push_back(page_id);
+        }
+    }
+    return page_ids;
+}
+
+size_t BufferPoolManager::WarmUp(const std::vector<page_id_t> &page_ids) {
+    if (disk_manager_->IsReadOnlyMapped()) {
+        return 0;
+    }
+
+    // The hottest of our pages that still exist, as many as there are frames; the list
+    // may be from before pages were deleted or the file was recreated
+    std::vector<page_id_t> pages;
+    std::unordered_set<page_id_t> seen;
+    page_id_t num_pages = disk_manager_->GetNumPages();
+    size_t limit = pool_size_.load();
+    for (page_id_t page_id : page_ids) {
+        if (pages.size() >= limit) {
+            break;
+        }
+        if (page_id >= 0 && page_id < num_pages && OwnsPage(page_id) && seen.insert(page_id).second) {
+            pages.push_back(page_id);
+        }
+    }
+    std::sort(pages.begin(), pages.end());
+
+    StopWarmup();
+    size_t queued = pages.size();
+    if (queued > 0) {
+        warmup_stop_ = false;
+        warmup_thread_ = std::thread(&BufferPoolManager::WarmupLoop, this, std::move(pages));
+    }
+    return queued;
+}
+
+void BufferPoolManager::WarmupLoop(std::vector<page_id_t> page_ids) {
+    // Only free frames are used: pages fetched since the start are never pushed out
+    for (size_t i = 0; i < page_ids.size() && !warmup_stop_.load(); i += WARMUP_BATCH_PAGES) {
+        size_t batch = std::min(WARMUP_BATCH_PAGES, page_ids.size() - i);
+        ReapReads(false);
+        StartReads(page_ids.data() + i, batch, false);
+        std::lock_guard<std::mutex> lock(free_list_latch_);
+        if (free_list_.empty()) {
+            break;
+        }
+    }
+}
+
+void BufferPoolManager::StopWarmup() {
+    if (warmup_thread_.joinable()) {
+        warmup_stop_ = true;
+        warmup_thread_.join();
+    }
+}
+
+void BufferPoolManager::SaveWarmupList() {
+    std::lock_guard<std::mutex> lock(warmup_latch_);
+    if (warmup_file_.empty()) {
+        return;
+    }
+    try {
+        WriteWarmupList(warmup_file_, GetHotPages());
+    } catch (const std::exception &) {
+        // Only a hint: losing it costs the next start its warm-up, nothing more
+    }
+}
+
+void BufferPoolManager::Resize(size_t new_size) {
+    if (new_size == 0 || new_size > MAX_POOL_FRAMES) {
+        throw std::invalid_argument("Buffer pool size must be between 1 and MAX_POOL_FRAMES");
+    }
+
+    std::lock_guard<std::mutex> resize_lock(resize_latch_);
+    if (new_size > pool_size_.load()) {
+        Grow(new_size);
+        return;
+    }
+    if (new_size < pool_size_.load()) {
+        // From here on no page is loaded into the frames past new_size; free ones retire now
+        std::lock_guard<std::mutex> lock(free_list_latch_);
+        pool_size_ = new_size;
+        for (auto it = free_list_.begin(); it != free_list_.end();) {
+            if (static_cast<size_t>(*it) >= new_size) {
+                Frame(*it).state = FrameState::RETIRED;
+                it = free_list_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    DrainFrames();
+}
+
+void BufferPoolManager::Grow(size_t new_size) {
+    // Chunks released while a frame below them was still draining get their memory back
+    size_t old_size = pool_size_.load();
+    for (FrameChunk &chunk : chunks_) {
+        size_t first = static_cast<size_t>(chunk.first_frame);
+        if (chunk.arena != nullptr || first >= new_size) {
+            continue;
+        }
+        chunk.arena.reset(new FrameArena(chunk.num_frames, use_huge_pages_));
+        for (size_t i = 0; i < chunk.num_frames; i++) {
+            Frame(static_cast<frame_id_t>(first + i)).page = &chunk.arena->GetFrames()[i];
+        }
+        allocated_frames_ += chunk.num_frames;
+    }
+    // Chunks end on FRAME_CHUNK_SIZE boundaries, so a pool grown in small steps still
+    // gives back whole chunks when it shrinks
+    while (num_frames_.load() < new_size) {
+        size_t num_frames = num_frames_.load();
+        AddChunk(std::min(new_size - num_frames, FRAME_CHUNK_SIZE - num_frames % FRAME_CHUNK_SIZE));
+    }
+
+    // Retired frames come back as free ones; frames still draining simply stay in service
+    std::lock_guard<std::mutex> lock(free_list_latch_);
+    pool_size_ = new_size;
+    for (size_t i = old_size; i < new_size; i++) {
+        FrameHeader &frame = Frame(static_cast<frame_id_t>(i));
+        if (frame.state.load() == FrameState::RETIRED) {
+            frame.state = FrameState::FREE;
+            free_list_.push_back(static_cast<frame_id_t>(i));
+        }
+    }
+}
+
+void BufferPoolManager::AddChunk(size_t num_frames) {
+    size_t first = num_frames_.load();
+    size_t end = first + num_frames;
+    for (; num_frame_blocks_ * FRAME_BLOCK_SIZE < end; num_frame_blocks_++) {
+        frame_blocks_[num_frame_blocks_].reset(new FrameHeader[FRAME_BLOCK_SIZE]);
+    }
+
+    FrameChunk chunk{static_cast<frame_id_t>(first), num_frames,
+                     std::unique_ptr<FrameArena>(new FrameArena(num_frames, use_huge_pages_))};
+    for (size_t i = 0; i < num_frames; i++) {
+        // Headers past an earlier, released chunk are reused; they were left retired
+        FrameHeader &frame = Frame(static_cast<frame_id_t>(first + i));
+        frame.page = &chunk.arena->GetFrames()[i];
+        frame.state = FrameState::RETIRED;
+    }
+    chunks_.push_back(std::move(chunk));
+    allocated_frames_ += num_frames;
+
+    // The replacer must know the frames before any of them can be unpinned
+    replacer_->SetNumFrames(end);
+    num_frames_ = end;
+}
+
+void BufferPoolManager::DrainFrames() {
+    // Evict what is resident and unpinned. Pinned and loading frames are left for a later
+    // round; free frames in someone's hands retire when they are returned.
+    size_t pool_size = pool_size_.load();
+    size_t num_frames = num_frames_.load();
+    for (size_t i = pool_size; i < num_frames; i++) {
+        frame_id_t frame_id = static_cast<frame_id_t>(i);
+        FrameHeader &frame = Frame(frame_id);
+        if (frame.state.load() != FrameState::READY || frame.pin_count.load() != 0) {
+            continue;
+        }
+        try {
+            if (EvictFrame(frame_id)) {
+                ReturnFrame(frame_id);
+            }
+        } catch (const std::exception &) {
+            // The write-back failed; the page stays resident and is tried again next round
+        }
+    }
+
+    // Release chunks wholly out of service once every frame in them is retired
+    for (FrameChunk &chunk : chunks_) {
+        size_t first = static_cast<size_t>(chunk.first_frame);
+        if (chunk.arena == nullptr || first < pool_size) {
+            continue;
+        }
+        bool retired = true;
+        for (size_t i = 0; i < chunk.num_frames && retired; i++) {
+            retired = Frame(static_cast<frame_id_t>(first + i)).state.load() == FrameState::RETIRED;
+        }
+        if (!retired) {
+            continue;
+        }
+        for (size_t i = 0; i < chunk.num_frames; i++) {
+            Frame(static_cast<frame_id_t>(first + i)).page = nullptr;
+        }
+        chunk.arena.reset();
+        allocated_frames_ -= chunk.num_frames;
+    }
+
+    // Released chunks at the end go away for good, and their frame ids with them
+    size_t end = num_frames;
+    while (!chunks_.empty() && chunks_.back().arena == nullptr) {
+        end = static_cast<size_t>(chunks_.back().first_frame);
+        chunks_.pop_back();
+    }
+    if (end < num_frames) {
+        num_frames_ = end;
+        replacer_->SetNumFrames(end);
+    }
+}
+
+BufferPoolStats &BufferPoolStats::operator+=(const BufferPoolStats &other) {
+    hits += other.hits;
+    misses += other.misses;
+    pin_waits += other.pin_waits;
+    frame_waits += other.frame_waits;
+    no_frame += other.no_frame;
+    evictions += other.evictions;
+    eviction_writes += other.eviction_writes;
+    background_writes += other.background_writes;
+    flush_writes += other.flush_writes;
+    pages_created += other.pages_created;
+    pages_deleted += other.pages_deleted;
+    prefetched += other.prefetched;
+    ring_reuses += other.ring_reuses;
+    return *this;
+}
+
+BufferPoolStats BufferPoolManager::GetStats() const {
+    BufferPoolStats stats;
+    stats.hits = counters_.Get(HITS);
+    stats.misses = counters_.Get(MISSES);
+    stats.pin_waits = counters_.Get(PIN_WAITS);
+    stats.frame_waits = counters_.Get(FRAME_WAITS);
+    stats.no_frame = counters_.Get(NO_FRAME);
+    stats.evictions = counters_.Get(EVICTIONS);
+    stats.eviction_writes = counters_.Get(EVICTION_WRITES);
+    stats.background_writes = counters_.Get(BACKGROUND_WRITES);
+    stats.flush_writes = counters_.Get(FLUSH_WRITES);
+    stats.pages_created = counters_.Get(PAGES_CREATED);
+    stats.pages_deleted = counters_.Get(PAGES_DELETED);
+    stats.prefetched = counters_.Get(PREFETCHED);
+    stats.ring_reuses = counters_.Get(RING_REUSES);
+    return stats;
+}
+
+std::string BufferPoolStats::ToString() const {
+    char hit_ratio[16];
+    snprintf(hit_ratio, sizeof(hit_ratio), "%.4f", HitRatio());
+    return "hits " + std::to_string(hits) + "\n" +
+           "misses " + std::to_string(misses) + "\n" +
+           "hit_ratio " + hit_ratio + "\n" +
+           "pin_waits " + std::to_string(pin_waits) + "\n" +
+           "frame_waits " + std::to_string(frame_waits) + "\n" +
+           "no_frame " + std::to_string(no_frame) + "\n" +
+           "evictions " + std::to_string(evictions) + "\n" +
+           "eviction_writes " + std::to_string(eviction_writes) + "\n" +
+           "background_writes " + std::to_string(background_writes) + "\n" +
+           "flush_writes " + std::to_string(flush_writes) + "\n" +
+           "pages_created " + std::to_string(pages_created) + "\n" +
+           "pages_deleted " + std::to_string(pages_deleted) + "\n" +
+           "prefetched " + std::to_string(prefetched) + "\n" +
+           "ring_reuses " + std::to_string(ring_reuses) + "\n";
+}
+
 }
@@ -0,0 +1,101 @@
+#include "storage/buffer/clock_replacer.h"
+
+#include <stdexcept>
+
+
+namespace dbengine {
+    ClockReplacer::ClockReplacer(size_t num_frames)
+        : num_frames_(num_frames), blocks_(new std::unique_ptr<Slot[]>[MAX_POOL_FRAMES / SLOT_BLOCK_SIZE]),
+          num_blocks_(0), size_(0), hand_(0) {
+        if (num_frames > MAX_POOL_FRAMES) {
+            throw std::invalid_argument("ClockReplacer: more than MAX_POOL_FRAMES frames");
+        }
+        AddBlocks(num_frames);
+    }
+
+    void ClockReplacer::AddBlocks(size_t num_frames) {
+        size_t needed = (num_frames + SLOT_BLOCK_SIZE - 1) / SLOT_BLOCK_SIZE;
+        for (; num_blocks_ < needed; num_blocks_++) {
+            blocks_[num_blocks_].reset(new Slot[SLOT_BLOCK_SIZE]);
+        }
+    }
+
+    bool ClockReplacer::Victim(frame_id_t *frame_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        // Two full turns: the first may only clear reference bits
+        for (size_t step = 0; step < 2 * num_frames_ && size_.load() > 0; step++) {
+            size_t frame = hand_;
+            hand_ = (hand_ + 1) % num_frames_;
+            Slot &slot = SlotOf(frame);
+            if (!slot.evictable.load()) {
+                continue;
+            }
+            if (slot.referenced.exchange(false)) {
+                continue; // Second chance
+            }
+            // A concurrent Pin may have won the frame since we looked
+            if (slot.evictable.exchange(false)) {
+                size_--;
+                *frame_id = static_cast<frame_id_t>(frame);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t ClockReplacer::NextVictims(frame_id_t *frame_ids, size_t max_frames) {
+        std::lock_guard<std::mutex> lock(latch_);
+        // A sweep takes unreferenced frames in hand order first; referenced ones only
+        // once their bits have been cleared on a later turn
+        size_t count = 0;
+        for (int referenced = 0; referenced < 2; referenced++) {
+            for (size_t step = 0; step < num_frames_ && count < max_frames; step++) {
+                size_t frame = (hand_ + step) % num_frames_;
+                Slot &slot = SlotOf(frame);
+                if (slot.evictable.load() && slot.referenced.load() == (referenced == 1)) {
+                    frame_ids[count++] = static_cast<frame_id_t>(frame);
+                }
+            }
+        }
+        return count;
+    }
+
+    void ClockReplacer::Pin(frame_id_t frame_id) {
+        if (SlotOf(frame_id).evictable.exchange(false)) {
+            size_--;
+        }
+    }
+
+    void ClockReplacer::Unpin(frame_id_t frame_id) {
+        if (!SlotOf(frame_id).evictable.exchange(true)) {
+            size_++;
+        }
+    }
+
+    void ClockReplacer::RecordAccess(frame_id_t frame_id, page_id_t page_id) {
+        (void)page_id;
+        SlotOf(frame_id).referenced.store(true, std::memory_order_relaxed);
+    }
+
+    void ClockReplacer::Remove(frame_id_t frame_id) {
+        Pin(frame_id);
+        SlotOf(frame_id).referenced = false;
+    }
+
+    size_t ClockReplacer::Size() {
+        return size_.load();
+    }
+
+    void ClockReplacer::SetNumFrames(size_t num_frames) {
+        if (num_frames > MAX_POOL_FRAMES) {
+            throw std::invalid_argument("ClockReplacer: more than MAX_POOL_FRAMES frames");
+        }
+        std::lock_guard<std::mutex> lock(latch_);
+        // Blocks are never freed: a lock-free caller may still be touching a frame past the end
+        AddBlocks(num_frames);
+        num_frames_ = num_frames;
+        if (hand_ >= num_frames_) {
+            hand_ = 0;
+        }
+    }
+}
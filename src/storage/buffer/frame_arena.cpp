@@ -0,0 +1,80 @@
+#include "storage/buffer/frame_arena.h"
+
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+
+namespace dbengine {
+
+static_assert(sizeof(Page) == PAGE_SIZE, "Frames must be exactly one page so they stay PAGE_SIZE aligned");
+
+FrameArena::FrameArena(size_t num_frames, bool use_huge_pages)
+    : base_(MAP_FAILED), mapped_size_(0), frames_(nullptr), num_frames_(num_frames), huge_pages_(false) {
+    size_t bytes = num_frames_ * PAGE_SIZE;
+    if (bytes == 0) {
+        bytes = PAGE_SIZE;
+    }
+
+    if (use_huge_pages) {
+        size_t rounded = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+#ifdef MAP_HUGETLB
+        // Explicit huge pages only succeed if the administrator reserved some
+        base_ = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base_ != MAP_FAILED) {
+            mapped_size_ = rounded;
+            huge_pages_ = true;
+        }
+#endif
+
+        if (base_ == MAP_FAILED) {
+            // Over-allocate so a 2MB-aligned region fits, then trim both ends
+            size_t reserve = rounded + HUGE_PAGE_SIZE;
+            void *raw = mmap(nullptr, reserve, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+
+            uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+            uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~(static_cast<uintptr_t>(HUGE_PAGE_SIZE) - 1);
+            size_t head = aligned - start;
+            size_t tail = reserve - head - rounded;
+            if (head > 0) {
+                munmap(raw, head);
+            }
+            if (tail > 0) {
+                munmap(reinterpret_cast<void *>(aligned + rounded), tail);
+            }
+
+            base_ = reinterpret_cast<void *>(aligned);
+            mapped_size_ = rounded;
+
+#ifdef MADV_HUGEPAGE
+            // Transparent huge pages: best effort, the kernel may decline
+            huge_pages_ = madvise(base_, mapped_size_, MADV_HUGEPAGE) == 0;
+#endif
+        }
+    } else {
+        // mmap returns OS-page-aligned memory, which is PAGE_SIZE aligned
+        base_ = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base_ == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        mapped_size_ = bytes;
+    }
+
+    frames_ = static_cast<Page *>(base_);
+    for (size_t i = 0; i < num_frames_; i++) {
+        new (&frames_[i]) Page();
+    }
+}
+
+FrameArena::~FrameArena() {
+    // Page is trivially destructible; just release the mapping
+    if (base_ != MAP_FAILED) {
+        munmap(base_, mapped_size_);
+    }
+}
+
+}
@@ -0,0 +1,102 @@
+#include "storage/buffer/lru_k_replacer.h"
+
+
+namespace dbengine {
+    LRUKReplacer::LRUKReplacer(size_t num_frames, size_t k)
+        : k_(k == 0 ? 1 : k), frames_(num_frames), current_time_(0) {
+    }
+
+    bool LRUKReplacer::Victim(frame_id_t *frame_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        if (evictable_.empty()) {
+            return false;
+        }
+
+        // Infinite distance sorts first; within a class the oldest access goes first
+        *frame_id = evictable_.begin()->second;
+        Reset(*frame_id);
+        return true;
+    }
+
+    size_t LRUKReplacer::NextVictims(frame_id_t *frame_ids, size_t max_frames) {
+        std::lock_guard<std::mutex> lock(latch_);
+        size_t count = 0;
+        for (auto it = evictable_.begin(); it != evictable_.end() && count < max_frames; ++it) {
+            frame_ids[count++] = it->second;
+        }
+        return count;
+    }
+
+    void LRUKReplacer::Pin(frame_id_t frame_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        FrameHistory &history = frames_[frame_id];
+        if (history.evictable) {
+            evictable_.erase(KeyOf(frame_id));
+            history.evictable = false;
+        }
+    }
+
+    void LRUKReplacer::Unpin(frame_id_t frame_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        FrameHistory &history = frames_[frame_id];
+        if (!history.evictable) {
+            history.evictable = true;
+            evictable_.insert(KeyOf(frame_id));
+        }
+    }
+
+    void LRUKReplacer::RecordAccess(frame_id_t frame_id, page_id_t page_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        FrameHistory &history = frames_[frame_id];
+        if (history.evictable) {
+            evictable_.erase(KeyOf(frame_id));
+        }
+        if (history.page_id != page_id) {
+            // First access since the frame was (re)loaded
+            history.accesses.clear();
+            history.page_id = page_id;
+        }
+        history.accesses.push_back(current_time_++);
+        if (history.accesses.size() > k_) {
+            history.accesses.pop_front();
+        }
+        if (history.evictable) {
+            evictable_.insert(KeyOf(frame_id));
+        }
+    }
+
+    void LRUKReplacer::Remove(frame_id_t frame_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        Reset(frame_id);
+    }
+
+    size_t LRUKReplacer::Size() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return evictable_.size();
+    }
+
+    LRUKReplacer::EvictionKey LRUKReplacer::KeyOf(frame_id_t frame_id) const {
+        const FrameHistory &history = frames_[frame_id];
+        bool finite = history.accesses.size() >= k_;
+        uint64_t time = history.accesses.empty() ? 0 : history.accesses.front();
+        return EvictionKey{{finite, time}, frame_id};
+    }
+
+    void LRUKReplacer::Reset(frame_id_t frame_id) {
+        FrameHistory &history = frames_[frame_id];
+        if (history.evictable) {
+            evictable_.erase(KeyOf(frame_id));
+        }
+        history.accesses.clear();
+        history.page_id = INVALID_PAGE_ID;
+        history.evictable = false;
+    }
+
+    void LRUKReplacer::SetNumFrames(size_t num_frames) {
+        std::lock_guard<std::mutex> lock(latch_);
+        // Entries past the end are kept: a late Unpin of a retired frame may still land there
+        if (num_frames > frames_.size()) {
+            frames_.resize(num_frames);
+        }
+    }
+}
@@ -6,6 +6,7 @@ namespace dbengine {
     }
 
     bool LRUReplacer::Victim(frame_id_t *frame_id_) {
+        std::lock_guard<std::mutex> lock(latch_);
         if (lru_list_.empty()) {
             return false;
         }
@@ -16,7 +17,17 @@ namespace dbengine {
         return true;
     }
 
+    size_t LRUReplacer::NextVictims(frame_id_t *frame_ids, size_t max_frames) {
+        std::lock_guard<std::mutex> lock(latch_);
+        size_t count = 0;
+        for (auto it = lru_list_.rbegin(); it != lru_list_.rend() && count < max_frames; ++it) {
+            frame_ids[count++] = *it;
+        }
+        return count;
+    }
+
     void LRUReplacer::Pin(frame_id_t frame_id) {
+        std::lock_guard<std::mutex> lock(latch_);
         auto it = lru_map_.find(frame_id);
         if (it != lru_map_.end()) {
             lru_list_.erase(it->second);
@@ -25,6 +36,7 @@ namespace dbengine {
     }
 
     void LRUReplacer::Unpin(frame_id_t frame_id) {
+        std::lock_guard<std::mutex> lock(latch_);
         if (lru_map_.count(frame_id)) {
             lru_list_.erase(lru_map_[frame_id]);
             lru_map_.erase(frame_id);
@@ -34,8 +46,14 @@ namespace dbengine {
     }
 
     size_t LRUReplacer::Size() {
+        std::lock_guard<std::mutex> lock(latch_);
         return lru_list_.size();
     }
 
+    void LRUReplacer::SetNumFrames(size_t num_frames) {
+        std::lock_guard<std::mutex> lock(latch_);
+        max_size_ = num_frames;
+    }
+
     
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "storage/buffer/page_guard.h"
+#include "storage/buffer/buffer_pool_manager.h"
+#include <utility>
+
+
+namespace dbengine {
+
+ReadPageGuard::ReadPageGuard(ReadPageGuard &&other) noexcept
+    : bpm_(other.bpm_), page_id_(other.page_id_), page_(other.page_), latch_(other.latch_) {
+    other.page_ = nullptr;
+    other.latch_ = nullptr;
+}
+
+ReadPageGuard &ReadPageGuard::operator=(ReadPageGuard &&other) noexcept {
+    if (this != &other) {
+        Drop();
+        bpm_ = other.bpm_;
+        page_id_ = other.page_id_;
+        page_ = std::exchange(other.page_, nullptr);
+        latch_ = std::exchange(other.latch_, nullptr);
+    }
+    return *this;
+}
+
+void ReadPageGuard::Drop() {
+    if (page_ == nullptr) {
+        return;
+    }
+    // Unlatch first: once unpinned the frame may be handed to another page
+    if (latch_ != nullptr) {
+        latch_->unlock_shared();
+    }
+    bpm_->UnpinPage(page_id_, false);
+    page_ = nullptr;
+    latch_ = nullptr;
+}
+
+WritePageGuard::WritePageGuard(WritePageGuard &&other) noexcept
+    : bpm_(other.bpm_), page_id_(other.page_id_), page_(other.page_), latch_(other.latch_),
+      is_dirty_(other.is_dirty_) {
+    other.page_ = nullptr;
+    other.latch_ = nullptr;
+    other.is_dirty_ = false;
+}
+
+WritePageGuard &WritePageGuard::operator=(WritePageGuard &&other) noexcept {
+    if (this != &other) {
+        Drop();
+        bpm_ = other.bpm_;
+        page_id_ = other.page_id_;
+        page_ = std::exchange(other.page_, nullptr);
+        latch_ = std::exchange(other.latch_, nullptr);
+        is_dirty_ = std::exchange(other.is_dirty_, false);
+    }
+    return *this;
+}
+
+void WritePageGuard::Drop() {
+    if (page_ == nullptr) {
+        return;
+    }
+    latch_->unlock();
+    bpm_->UnpinPage(page_id_, is_dirty_);
+    page_ = nullptr;
+    latch_ = nullptr;
+    is_dirty_ = false;
+}
+
+}
@@ -0,0 +1,131 @@
+#include "storage/buffer/page_table.h"
+
+
+namespace dbengine {
+
+// Smallest table; keeps tiny pools from rehashing on their first inserts
+static constexpr size_t MIN_CAPACITY = 16;
+
+PageTable::PageTable() : current_(nullptr), size_(0) {
+    arrays_.push_back(std::make_unique<SlotArray>(MIN_CAPACITY));
+    current_.store(arrays_.back().get());
+}
+
+void PageTable::Reserve(size_t num_entries) {
+    size_t capacity = MIN_CAPACITY;
+    while (capacity < 2 * num_entries) {
+        capacity *= 2;
+    }
+    if (capacity > current_.load()->mask + 1) {
+        Rehash(capacity);
+    }
+}
+
+frame_id_t PageTable::Find(page_id_t page_id) const {
+    const SlotArray *array = current_.load(std::memory_order_acquire);
+    size_t i = Home(page_id, array->mask);
+    while (true) {
+        const Slot &slot = array->slots[i];
+        page_id_t key = slot.page_id.load(std::memory_order_acquire);
+        if (key == page_id) {
+            frame_id_t frame_id = slot.frame_id.load(std::memory_order_acquire);
+            // An Erase may have shifted another entry into this slot between the two loads
+            if (slot.page_id.load(std::memory_order_relaxed) == page_id) {
+                return frame_id;
+            }
+            return NO_FRAME;
+        }
+        if (key == INVALID_PAGE_ID) {
+            return NO_FRAME;
+        }
+        i = (i + 1) & array->mask;
+    }
+}
+
+bool PageTable::Insert(page_id_t page_id, frame_id_t frame_id) {
+    SlotArray *array = current_.load();
+    if (2 * (size_ + 1) > array->mask + 1) {
+        Rehash(2 * (array->mask + 1));
+        array = current_.load();
+    }
+
+    size_t i = Home(page_id, array->mask);
+    while (true) {
+        Slot &slot = array->slots[i];
+        page_id_t key = slot.page_id.load(std::memory_order_relaxed);
+        if (key == page_id) {
+            return false;
+        }
+        if (key == INVALID_PAGE_ID) {
+            // Frame first: a reader that sees the key sees its frame
+            slot.frame_id.store(frame_id, std::memory_order_relaxed);
+            slot.page_id.store(page_id, std::memory_order_release);
+            size_++;
+            return true;
+        }
+        i = (i + 1) & array->mask;
+    }
+}
+
+bool PageTable::Erase(page_id_t page_id) {
+    SlotArray *array = current_.load();
+    size_t mask = array->mask;
+    size_t i = Home(page_id, mask);
+    while (true) {
+        page_id_t key = array->slots[i].page_id.load(std::memory_order_relaxed);
+        if (key == page_id) {
+            break;
+        }
+        if (key == INVALID_PAGE_ID) {
+            return false;
+        }
+        i = (i + 1) & mask;
+    }
+
+    // Backward shift: pull later entries of the run into the hole unless their home
+    // lies cyclically in (hole, j], where they would no longer be reachable
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        page_id_t key = array->slots[j].page_id.load(std::memory_order_relaxed);
+        if (key == INVALID_PAGE_ID) {
+            break;
+        }
+        size_t home = Home(key, mask);
+        bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+        if (stays) {
+            continue;
+        }
+        array->slots[i].frame_id.store(array->slots[j].frame_id.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        array->slots[i].page_id.store(key, std::memory_order_release);
+        i = j;
+    }
+
+    array->slots[i].page_id.store(INVALID_PAGE_ID, std::memory_order_release);
+    array->slots[i].frame_id.store(NO_FRAME, std::memory_order_relaxed);
+    size_--;
+    return true;
+}
+
+void PageTable::Rehash(size_t capacity) {
+    const SlotArray *old_array = current_.load();
+    auto array = std::make_unique<SlotArray>(capacity);
+    for (size_t i = 0; i <= old_array->mask; i++) {
+        page_id_t key = old_array->slots[i].page_id.load(std::memory_order_relaxed);
+        if (key == INVALID_PAGE_ID) {
+            continue;
+        }
+        size_t j = Home(key, array->mask);
+        while (array->slots[j].page_id.load(std::memory_order_relaxed) != INVALID_PAGE_ID) {
+            j = (j + 1) & array->mask;
+        }
+        array->slots[j].frame_id.store(old_array->slots[i].frame_id.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        array->slots[j].page_id.store(key, std::memory_order_relaxed);
+    }
+
+    // Published complete; readers already probing the old array finish there
+    current_.store(array.get(), std::memory_order_release);
+    arrays_.push_back(std::move(array));
+}
+
+}
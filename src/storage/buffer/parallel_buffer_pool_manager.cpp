@@ -0,0 +1,213 @@
+#include "storage/buffer/parallel_buffer_pool_manager.h"
+#include "storage/buffer/warmup_list.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace dbengine {
+
+ParallelBufferPoolManager::ParallelBufferPoolManager(size_t num_instances, size_t pool_size, DiskManager *disk_manager,
+                                                     bool use_huge_pages, ReplacerType replacer_type)
+    : pool_size_(pool_size), disk_manager_(disk_manager) {
+    if (num_instances == 0) {
+        throw std::invalid_argument("ParallelBufferPoolManager needs at least one instance");
+    }
+    instances_.reserve(num_instances);
+    for (size_t i = 0; i < num_instances; i++) {
+        instances_.emplace_back(
+            new BufferPoolManager(pool_size, disk_manager, use_huge_pages, replacer_type, i, num_instances));
+    }
+
+    // The window is a span of page ids shared by all instances: size it for the whole pool
+    SetReadAheadWindow(std::min<size_t>(BufferPoolManager::DEFAULT_READ_AHEAD_WINDOW, GetPoolSize() / 4));
+}
+
+ParallelBufferPoolManager::~ParallelBufferPoolManager() {
+    // The instances flush their own pages as they go, but only the whole pool knows the list
+    SaveWarmupList();
+}
+
+Page *ParallelBufferPoolManager::FetchPage(page_id_t page_id) {
+    return GetInstance(page_id)->FetchPage(page_id);
+}
+
+ReadPageGuard ParallelBufferPoolManager::FetchPageRead(page_id_t page_id) {
+    return GetInstance(page_id)->FetchPageRead(page_id);
+}
+
+ReadPageGuard ParallelBufferPoolManager::FetchPageRead(page_id_t page_id, ScanRing *ring) {
+    if (ring == nullptr) {
+        return FetchPageRead(page_id);
+    }
+    size_t index = static_cast<size_t>(page_id) % instances_.size();
+    return instances_[index]->FetchPageRead(page_id, ring->parts_[index].get());
+}
+
+std::unique_ptr<ScanRing> ParallelBufferPoolManager::NewScanRing(size_t num_frames) {
+    if (num_frames == 0) {
+        throw std::invalid_argument("A scan ring needs at least one frame");
+    }
+    // A scan touches every instance in turn; a part of two frames still lets one read ahead
+    std::unique_ptr<ScanRing> ring(new ScanRing(num_frames));
+    size_t part_frames = std::max<size_t>(2, num_frames / instances_.size());
+    for (auto &instance : instances_) {
+        ring->parts_.push_back(instance->NewScanRing(part_frames));
+    }
+    return ring;
+}
+
+WritePageGuard ParallelBufferPoolManager::FetchPageWrite(page_id_t page_id) {
+    return GetInstance(page_id)->FetchPageWrite(page_id);
+}
+
+bool ParallelBufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
+    return GetInstance(page_id)->UnpinPage(page_id, is_dirty);
+}
+
+bool ParallelBufferPoolManager::FlushPage(page_id_t page_id) {
+    return GetInstance(page_id)->FlushPage(page_id);
+}
+
+Page *ParallelBufferPoolManager::NewPage(page_id_t *page_id) {
+    return NewPage(page_id, nullptr);
+}
+
+Page *ParallelBufferPoolManager::NewPage(page_id_t *page_id, PageExtent *extent) {
+    if (disk_manager_->IsReadOnlyMapped()) {
+        return nullptr; // Read-only file
+    }
+
+    // The id decides the instance, so it is allocated first
+    page_id_t new_page_id = extent != nullptr ? disk_manager_->AllocatePage(extent) : disk_manager_->AllocatePage();
+    Page *page = GetInstance(new_page_id)->NewPageWithId(new_page_id);
+    if (page == nullptr) {
+        disk_manager_->DeallocatePage(new_page_id); // Give the id back for a later attempt
+        return nullptr;
+    }
+
+    *page_id = new_page_id;
+    return page;
+}
+
+void ParallelBufferPoolManager::ReleaseExtent(PageExtent *extent) {
+    disk_manager_->ReleaseExtent(extent);
+}
+
+WritePageGuard ParallelBufferPoolManager::NewPageGuarded(page_id_t *page_id, PageExtent *extent) {
+    Page *page = NewPage(page_id, extent);
+    if (page == nullptr) {
+        return WritePageGuard();
+    }
+    return GetInstance(*page_id)->GuardNewPage(*page_id, page);
+}
+
+bool ParallelBufferPoolManager::DeletePage(page_id_t page_id) {
+    return GetInstance(page_id)->DeletePage(page_id);
+}
+
+void ParallelBufferPoolManager::FlushAllPages() {
+    SaveWarmupList();
+    for (auto &instance : instances_) {
+        instance->FlushAllPages();
+    }
+}
+
+size_t ParallelBufferPoolManager::Prefetch(page_id_t page_id, size_t num_pages) {
+    size_t started = 0;
+    for (auto &instance : instances_) {
+        started += instance->Prefetch(page_id, num_pages);
+    }
+    return started;
+}
+
+void ParallelBufferPoolManager::HintSequential(page_id_t page_id, ScanRing *ring) {
+    if (page_id == INVALID_PAGE_ID) {
+        return;
+    }
+    // Each instance is told where its own part of the scan starts
+    page_id_t num_instances = static_cast<page_id_t>(instances_.size());
+    for (page_id_t i = 0; i < num_instances; i++) {
+        page_id_t first_owned = page_id + (i - page_id % num_instances + num_instances) % num_instances;
+        instances_[i]->HintSequential(first_owned, ring != nullptr ? ring->parts_[i].get() : nullptr);
+    }
+}
+
+BufferPoolStats ParallelBufferPoolManager::GetStats() const {
+    BufferPoolStats stats;
+    for (auto &instance : instances_) {
+        stats += instance->GetStats();
+    }
+    return stats;
+}
+
+void ParallelBufferPoolManager::SetReadAheadWindow(size_t num_pages) {
+    for (auto &instance : instances_) {
+        instance->SetReadAheadWindow(num_pages);
+    }
+}
+
+void ParallelBufferPoolManager::SetBackgroundWriterRate(size_t pages_per_second) {
+    for (auto &instance : instances_) {
+        instance->SetBackgroundWriterRate(pages_per_second);
+    }
+}
+
+void ParallelBufferPoolManager::Resize(size_t pool_size) {
+    for (auto &instance : instances_) {
+        instance->Resize(pool_size);
+    }
+    pool_size_ = pool_size;
+}
+
+size_t ParallelBufferPoolManager::EnableWarmup() {
+    if (disk_manager_->IsReadOnlyMapped()) {
+        return 0;
+    }
+    std::string file_name = WarmupFileName(disk_manager_->GetFileName());
+    {
+        std::lock_guard<std::mutex> lock(warmup_latch_);
+        warmup_file_ = file_name;
+    }
+    // Each instance picks out the pages it owns
+    std::vector<page_id_t> page_ids = ReadWarmupList(file_name);
+    size_t queued = 0;
+    for (auto &instance : instances_) {
+        queued += instance->WarmUp(page_ids);
+    }
+    return queued;
+}
+
+std::vector<page_id_t> ParallelBufferPoolManager::GetHotPages() {
+    std::vector<std::vector<page_id_t>> lists;
+    size_t longest = 0;
+    for (auto &instance : instances_) {
+        lists.push_back(instance->GetHotPages());
+        longest = std::max(longest, lists.back().size());
+    }
+
+    // Round-robin, so a smaller pool after a restart still gets each instance's hottest pages
+    std::vector<page_id_t> page_ids;
+    for (size_t i = 0; i < longest; i++) {
+        for (auto &list : lists) {
+            if (i < list.size()) {
+                page_ids.push_back(list[i]);
+            }
+        }
+    }
+    return page_ids;
+}
+
+void ParallelBufferPoolManager::SaveWarmupList() {
+    std::lock_guard<std::mutex> lock(warmup_latch_);
+    if (warmup_file_.empty()) {
+        return;
+    }
+    try {
+        WriteWarmupList(warmup_file_, GetHotPages());
+    } catch (const std::exception &) {
+        // Only a hint: losing it costs the next start its warm-up, nothing more
+    }
+}
+
+}
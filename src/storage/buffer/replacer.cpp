@@ -0,0 +1,25 @@
+#include "storage/buffer/replacer.h"
+#include "storage/buffer/clock_replacer.h"
+#include "storage/buffer/lru_k_replacer.h"
+#include "storage/buffer/lru_replacer.h"
+#include "storage/buffer/two_queue_replacer.h"
+
+#include <stdexcept>
+
+namespace dbengine {
+
+std::unique_ptr<Replacer> Replacer::Create(ReplacerType type, size_t num_frames) {
+    switch (type) {
+        case ReplacerType::LRU:
+            return std::make_unique<LRUReplacer>(num_frames);
+        case ReplacerType::CLOCK:
+            return std::make_unique<ClockReplacer>(num_frames);
+        case ReplacerType::LRU_K:
+            return std::make_unique<LRUKReplacer>(num_frames);
+        case ReplacerType::TWO_Q:
+            return std::make_unique<TwoQueueReplacer>(num_frames);
+    }
+    throw std::invalid_argument("Unknown replacer type");
+}
+
+}
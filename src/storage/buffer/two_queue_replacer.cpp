@@ -0,0 +1,194 @@
+#include "storage/buffer/two_queue_replacer.h"
+
+#include <algorithm>
+
+
+namespace dbengine {
+    // A1out remembers twice as many ids as there are frames. An id costs a few dozen
+    // bytes against a 4KB frame, and the longer memory lets the working set be
+    // recognized across scan bursts larger than the pool.
+    TwoQueueReplacer::TwoQueueReplacer(size_t num_frames)
+        : frames_(num_frames), kin_(std::max<size_t>(1, num_frames / 4)),
+          a1out_capacity_(std::max<size_t>(1, num_frames * 2)), size_(0) {
+    }
+
+    bool TwoQueueReplacer::Victim(frame_id_t *frame_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        if (size_ == 0) {
+            return false;
+        }
+
+        // Drain A1in while it is over its share; otherwise Am's LRU end goes first
+        bool found = false;
+        if (a1in_.size() > kin_) {
+            found = FindEvictable(a1in_, true, frame_id);
+        }
+        if (!found) {
+            found = FindEvictable(am_, false, frame_id) || FindEvictable(a1in_, true, frame_id);
+        }
+        if (!found) {
+            return false;
+        }
+
+        FrameEntry &entry = frames_[*frame_id];
+        if (entry.queue == Queue::A1IN && entry.page_id != INVALID_PAGE_ID) {
+            RememberGhost(entry.page_id);
+        }
+        Detach(*frame_id);
+        size_--;
+        return true;
+    }
+
+    size_t TwoQueueReplacer::NextVictims(frame_id_t *frame_ids, size_t max_frames) {
+        std::lock_guard<std::mutex> lock(latch_);
+        // Same order as repeated Victim calls: A1in while it is over its share, then
+        // Am from its LRU end, then what is left of A1in
+        auto in_it = a1in_.begin();
+        auto am_it = am_.rbegin();
+        size_t in_size = a1in_.size();
+        size_t count = 0;
+        while (count < max_frames) {
+            while (in_it != a1in_.end() && !frames_[*in_it].evictable) {
+                ++in_it;
+            }
+            while (am_it != am_.rend() && !frames_[*am_it].evictable) {
+                ++am_it;
+            }
+            if (in_it != a1in_.end() && (in_size > kin_ || am_it == am_.rend())) {
+                frame_ids[count++] = *in_it++;
+                in_size--;
+            } else if (am_it != am_.rend()) {
+                frame_ids[count++] = *am_it++;
+            } else {
+                break;
+            }
+        }
+        return count;
+    }
+
+    void TwoQueueReplacer::Pin(frame_id_t frame_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        FrameEntry &entry = frames_[frame_id];
+        if (entry.evictable) {
+            entry.evictable = false;
+            size_--;
+        }
+    }
+
+    void TwoQueueReplacer::Unpin(frame_id_t frame_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        FrameEntry &entry = frames_[frame_id];
+        if (entry.queue == Queue::NONE) {
+            // Never accessed (read-ahead): first in line to go
+            a1in_.push_back(frame_id);
+            entry.position = std::prev(a1in_.end());
+            entry.queue = Queue::A1IN;
+        }
+        if (!entry.evictable) {
+            entry.evictable = true;
+            size_++;
+        }
+    }
+
+    void TwoQueueReplacer::RecordAccess(frame_id_t frame_id, page_id_t page_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        FrameEntry &entry = frames_[frame_id];
+        if (entry.queue != Queue::NONE && entry.page_id == page_id) {
+            if (entry.queue == Queue::AM) {
+                am_.splice(am_.begin(), am_, entry.position);
+            }
+            return; // Correlated re-reference while in A1in
+        }
+
+        // First access to this page since it was loaded
+        if (entry.queue == Queue::A1IN) {
+            a1in_.erase(entry.position);
+        } else if (entry.queue == Queue::AM) {
+            am_.erase(entry.position);
+        }
+        entry.page_id = page_id;
+
+        auto ghost = a1out_map_.find(page_id);
+        if (ghost != a1out_map_.end()) {
+            a1out_.erase(ghost->second);
+            a1out_map_.erase(ghost);
+            am_.push_front(frame_id);
+            entry.position = am_.begin();
+            entry.queue = Queue::AM;
+        } else {
+            a1in_.push_back(frame_id);
+            entry.position = std::prev(a1in_.end());
+            entry.queue = Queue::A1IN;
+        }
+    }
+
+    void TwoQueueReplacer::Remove(frame_id_t frame_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        if (frames_[frame_id].evictable) {
+            size_--;
+        }
+        Detach(frame_id);
+    }
+
+    size_t TwoQueueReplacer::Size() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return size_;
+    }
+
+    bool TwoQueueReplacer::FindEvictable(const std::list<frame_id_t> &queue, bool from_front, frame_id_t *frame_id) const {
+        if (from_front) {
+            for (frame_id_t frame : queue) {
+                if (frames_[frame].evictable) {
+                    *frame_id = frame;
+                    return true;
+                }
+            }
+        } else {
+            for (auto it = queue.rbegin(); it != queue.rend(); ++it) {
+                if (frames_[*it].evictable) {
+                    *frame_id = *it;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void TwoQueueReplacer::Detach(frame_id_t frame_id) {
+        FrameEntry &entry = frames_[frame_id];
+        if (entry.queue == Queue::A1IN) {
+            a1in_.erase(entry.position);
+        } else if (entry.queue == Queue::AM) {
+            am_.erase(entry.position);
+        }
+        entry.queue = Queue::NONE;
+        entry.page_id = INVALID_PAGE_ID;
+        entry.evictable = false;
+    }
+
+    void TwoQueueReplacer::RememberGhost(page_id_t page_id) {
+        if (a1out_map_.count(page_id) != 0) {
+            return;
+        }
+        a1out_.push_back(page_id);
+        a1out_map_[page_id] = std::prev(a1out_.end());
+        if (a1out_.size() > a1out_capacity_) {
+            a1out_map_.erase(a1out_.front());
+            a1out_.pop_front();
+        }
+    }
+
+    void TwoQueueReplacer::SetNumFrames(size_t num_frames) {
+        std::lock_guard<std::mutex> lock(latch_);
+        // Entries past the end are kept: a late Unpin of a retired frame may still land there
+        if (num_frames > frames_.size()) {
+            frames_.resize(num_frames);
+        }
+        kin_ = std::max<size_t>(1, num_frames / 4);
+        a1out_capacity_ = std::max<size_t>(1, num_frames * 2);
+        while (a1out_.size() > a1out_capacity_) {
+            a1out_map_.erase(a1out_.front());
+            a1out_.pop_front();
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#include "storage/buffer/warmup_list.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dbengine {
+
+static constexpr uint32_t WARMUP_MAGIC = 0x5741524D; // "WARM"
+static constexpr uint32_t WARMUP_VERSION = 1;
+
+// On-disk header; the page ids follow it
+struct WarmupHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t num_pages;
+};
+
+static bool WriteAll(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static bool ReadAll(int fd, char *data, size_t length) {
+    while (length > 0) {
+        ssize_t n = read(fd, data, length);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+std::string WarmupFileName(const std::string &db_file) {
+    return db_file + ".warmup";
+}
+
+void WriteWarmupList(const std::string &file_name, const std::vector<page_id_t> &page_ids) {
+    // A crash mid-write leaves the old list (or none), never a half-written one
+    std::string temp_name = file_name + ".tmp";
+    int fd = open(temp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create warm-up list: " + temp_name);
+    }
+
+    WarmupHeader header{WARMUP_MAGIC, WARMUP_VERSION, page_ids.size()};
+    bool written = WriteAll(fd, reinterpret_cast<const char *>(&header), sizeof(header)) &&
+                   WriteAll(fd, reinterpret_cast<const char *>(page_ids.data()), page_ids.size() * sizeof(page_id_t));
+    if (close(fd) != 0 || !written || rename(temp_name.c_str(), file_name.c_str()) != 0) {
+        unlink(temp_name.c_str());
+        throw std::runtime_error("Failed to write warm-up list: " + file_name);
+    }
+}
+
+std::vector<page_id_t> ReadWarmupList(const std::string &file_name) {
+    std::vector<page_id_t> page_ids;
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return page_ids; // No list saved yet
+    }
+
+    WarmupHeader header;
+    struct stat st;
+    bool valid = ReadAll(fd, reinterpret_cast<char *>(&header), sizeof(header)) && header.magic == WARMUP_MAGIC &&
+                 header.version == WARMUP_VERSION && fstat(fd, &st) == 0 &&
+                 header.num_pages == (static_cast<uint64_t>(st.st_size) - sizeof(header)) / sizeof(page_id_t);
+    if (valid) {
+        page_ids.resize(header.num_pages);
+        if (!ReadAll(fd, reinterpret_cast<char *>(page_ids.data()), page_ids.size() * sizeof(page_id_t))) {
+            page_ids.clear();
+        }
+    }
+    close(fd);
+    return page_ids;
+}
+
+}
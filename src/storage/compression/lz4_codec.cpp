@@ -0,0 +1,198 @@
+#include "storage/compression/lz4_codec.h"
+
+#include <cstring>
+
+namespace dbengine {
+
+// Format constants from the LZ4 block specification
+static constexpr size_t MIN_MATCH = 4;
+static constexpr size_t LAST_LITERALS = 5;     // The last 5 bytes are always literals
+static constexpr size_t MATCH_SAFE_DISTANCE = 12; // No match may start within 12 bytes of the end
+static constexpr size_t MAX_OFFSET = 65535;
+
+static constexpr int HASH_BITS = 12;
+
+static inline uint32_t Read32(const char *p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint32_t Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Emit a length that did not fit in a 4-bit token field as 255-continued bytes
+static inline bool WriteLengthExtension(size_t length, char *&out, const char *out_end) {
+    while (length >= 255) {
+        if (out >= out_end) {
+            return false;
+        }
+        *out++ = static_cast<char>(255);
+        length -= 255;
+    }
+    if (out >= out_end) {
+        return false;
+    }
+    *out++ = static_cast<char>(length);
+    return true;
+}
+
+static bool WriteSequence(const char *literals, size_t literal_length, size_t match_length, size_t offset,
+                          bool last, char *&out, const char *out_end) {
+    if (out >= out_end) {
+        return false;
+    }
+    char *token = out++;
+    uint8_t token_value = static_cast<uint8_t>((literal_length >= 15 ? 15 : literal_length) << 4);
+
+    if (literal_length >= 15 && !WriteLengthExtension(literal_length - 15, out, out_end)) {
+        return false;
+    }
+    if (static_cast<size_t>(out_end - out) < literal_length) {
+        return false;
+    }
+    std::memcpy(out, literals, literal_length);
+    out += literal_length;
+
+    if (!last) {
+        if (out_end - out < 2) {
+            return false;
+        }
+        *out++ = static_cast<char>(offset & 0xFF);
+        *out++ = static_cast<char>(offset >> 8);
+
+        size_t extra = match_length - MIN_MATCH;
+        token_value |= static_cast<uint8_t>(extra >= 15 ? 15 : extra);
+        if (extra >= 15 && !WriteLengthExtension(extra - 15, out, out_end)) {
+            return false;
+        }
+    }
+
+    *token = static_cast<char>(token_value);
+    return true;
+}
+
+size_t Lz4Codec::Compress(const char *src, size_t src_size, char *dst, size_t dst_capacity) {
+    char *out = dst;
+    const char *out_end = dst + dst_capacity;
+    const char *anchor = src;
+
+    if (src_size >= MATCH_SAFE_DISTANCE + 1) {
+        // Positions (relative to src) of the last occurrence of each 4-byte hash
+        uint32_t table[1 << HASH_BITS];
+        std::memset(table, 0xFF, sizeof(table));
+
+        const char *match_limit = src + src_size - MATCH_SAFE_DISTANCE;
+        const char *match_end_limit = src + src_size - LAST_LITERALS;
+        const char *ip = src;
+
+        while (ip < match_limit) {
+            uint32_t sequence = Read32(ip);
+            uint32_t h = Hash(sequence);
+            uint32_t candidate = table[h];
+            table[h] = static_cast<uint32_t>(ip - src);
+
+            if (candidate == 0xFFFFFFFF || static_cast<size_t>(ip - src) - candidate > MAX_OFFSET ||
+                Read32(src + candidate) != sequence) {
+                ip++;
+                continue;
+            }
+
+            // Extend the match forward, stopping before the mandatory trailing literals
+            const char *match = src + candidate;
+            const char *match_end = ip + MIN_MATCH;
+            const char *ref = match + MIN_MATCH;
+            while (match_end < match_end_limit && *match_end == *ref) {
+                match_end++;
+                ref++;
+            }
+
+            if (!WriteSequence(anchor, static_cast<size_t>(ip - anchor), static_cast<size_t>(match_end - ip),
+                               static_cast<size_t>(ip - match), false, out, out_end)) {
+                return 0;
+            }
+
+            ip = match_end;
+            anchor = ip;
+        }
+    }
+
+    // Final run of literals
+    if (!WriteSequence(anchor, static_cast<size_t>(src + src_size - anchor), 0, 0, true, out, out_end)) {
+        return 0;
+    }
+    return static_cast<size_t>(out - dst);
+}
+
+size_t Lz4Codec::Decompress(const char *src, size_t src_size, char *dst, size_t dst_capacity) {
+    const uint8_t *ip = reinterpret_cast<const uint8_t *>(src);
+    const uint8_t *ip_end = ip + src_size;
+    char *op = dst;
+    char *op_end = dst + dst_capacity;
+
+    while (ip < ip_end) {
+        uint8_t token = *ip++;
+
+        size_t literal_length = token >> 4;
+        if (literal_length == 15) {
+            uint8_t byte;
+            do {
+                if (ip >= ip_end) {
+                    return 0;
+                }
+                byte = *ip++;
+                literal_length += byte;
+            } while (byte == 255);
+        }
+
+        if (static_cast<size_t>(ip_end - ip) < literal_length || static_cast<size_t>(op_end - op) < literal_length) {
+            return 0;
+        }
+        std::memcpy(op, ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+
+        // The last sequence has literals only
+        if (ip == ip_end) {
+            break;
+        }
+
+        if (ip_end - ip < 2) {
+            return 0;
+        }
+        size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+            return 0;
+        }
+
+        size_t match_length = token & 0x0F;
+        if (match_length == 15) {
+            uint8_t byte;
+            do {
+                if (ip >= ip_end) {
+                    return 0;
+                }
+                byte = *ip++;
+                match_length += byte;
+            } while (byte == 255);
+        }
+        match_length += MIN_MATCH;
+
+        if (static_cast<size_t>(op_end - op) < match_length) {
+            return 0;
+        }
+
+        // Byte-wise copy: the match may overlap the bytes it produces (runs)
+        const char *match = op - offset;
+        for (size_t i = 0; i < match_length; i++) {
+            op[i] = match[i];
+        }
+        op += match_length;
+    }
+
+    return static_cast<size_t>(op - dst);
+}
+
+}
@@ -0,0 +1,251 @@
+#include "storage/disk/allocation_bitmap.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dbengine {
+
+static constexpr uint32_t ALLOCATION_MAGIC = 0x414C4F43; // "ALOC"
+static constexpr uint32_t ALLOCATION_VERSION = 1;
+
+// Full-page positional I/O on the bitmap file. Reads past the end return zeros.
+static bool ReadFull(int fd, char *data, uint64_t offset) {
+    size_t done = 0;
+    while (done < PAGE_SIZE) {
+        ssize_t n = pread(fd, data + done, PAGE_SIZE - done, offset + done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            return false;
+        }
+        if (n == 0) {
+            memset(data + done, 0, PAGE_SIZE - done);
+            break;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static bool WriteFull(int fd, const char *data, uint64_t offset) {
+    size_t done = 0;
+    while (done < PAGE_SIZE) {
+        ssize_t n = pwrite(fd, data + done, PAGE_SIZE - done, offset + done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+AllocationBitmap::AllocationBitmap(const std::string &file_name, bool reset)
+    : fd_(-1), file_name_(file_name), header_dirty_(false), search_hint_(0) {
+    int flags = O_RDWR | O_CREAT | (reset ? O_TRUNC : 0);
+    fd_ = open(file_name_.c_str(), flags, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to open allocation bitmap file: " + file_name_);
+    }
+
+    if (!ReadFull(fd_, reinterpret_cast<char *>(&header_), 0)) {
+        close(fd_);
+        throw std::runtime_error("Failed to read allocation bitmap header: " + file_name_);
+    }
+
+    if (header_.magic != ALLOCATION_MAGIC) {
+        // New (or unrecognised) file: start with nothing free
+        memset(&header_, 0, sizeof(header_));
+        header_.magic = ALLOCATION_MAGIC;
+        header_.version = ALLOCATION_VERSION;
+        header_dirty_ = true;
+    } else if (header_.version != ALLOCATION_VERSION || header_.num_bitmap_pages > MAX_BITMAP_PAGES) {
+        close(fd_);
+        throw std::runtime_error("Unsupported allocation bitmap file: " + file_name_);
+    }
+
+    // Only the header is read here; bitmap pages are loaded on demand
+    bitmap_pages_.resize(header_.num_bitmap_pages);
+}
+
+AllocationBitmap::~AllocationBitmap() {
+    try {
+        Flush();
+    } catch (const std::exception &) {
+        // Losing unflushed frees only leaks pages; never throw from a destructor
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+uint64_t *AllocationBitmap::LoadBitmapPage(uint32_t index) {
+    BitmapPage &bitmap_page = bitmap_pages_[index];
+    if (bitmap_page.words == nullptr) {
+        bitmap_page.words.reset(new uint64_t[WORDS_PER_BITMAP_PAGE]);
+        uint64_t offset = static_cast<uint64_t>(index + 1) * PAGE_SIZE;
+        if (!ReadFull(fd_, reinterpret_cast<char *>(bitmap_page.words.get()), offset)) {
+            bitmap_page.words.reset();
+            throw std::runtime_error("Failed to read allocation bitmap page: " + file_name_);
+        }
+    }
+    return bitmap_page.words.get();
+}
+
+void AllocationBitmap::WriteBitmapPage(uint32_t index) {
+    uint64_t offset = static_cast<uint64_t>(index + 1) * PAGE_SIZE;
+    if (!WriteFull(fd_, reinterpret_cast<const char *>(bitmap_pages_[index].words.get()), offset)) {
+        throw std::runtime_error("Failed to write allocation bitmap page: " + file_name_);
+    }
+    bitmap_pages_[index].dirty = false;
+}
+
+void AllocationBitmap::WriteHeader() {
+    if (!WriteFull(fd_, reinterpret_cast<const char *>(&header_), 0)) {
+        throw std::runtime_error("Failed to write allocation bitmap header: " + file_name_);
+    }
+    header_dirty_ = false;
+}
+
+page_id_t AllocationBitmap::AllocateFreePage() {
+    uint32_t num_pages;
+    return AllocateFreeRun(1, &num_pages);
+}
+
+page_id_t AllocationBitmap::AllocateFreeRun(uint32_t max_pages, uint32_t *num_pages, uint32_t boundary) {
+    *num_pages = 0;
+    for (uint32_t index = search_hint_; index < header_.num_bitmap_pages; index++) {
+        if (header_.free_counts[index] == 0) {
+            continue;
+        }
+
+        uint64_t *words = LoadBitmapPage(index);
+        for (uint32_t w = 0; w < WORDS_PER_BITMAP_PAGE; w++) {
+            if (words[w] == 0) {
+                continue;
+            }
+
+            // Lowest set bit is the lowest free page in this word; the run goes on
+            // while the following pages are free, within this bitmap page
+            uint32_t first = w * 64 + static_cast<uint32_t>(__builtin_ctzll(words[w]));
+            uint32_t bit_index = first;
+            while (*num_pages < max_pages && bit_index < PAGES_PER_BITMAP_PAGE) {
+                uint64_t page = static_cast<uint64_t>(index) * PAGES_PER_BITMAP_PAGE + bit_index;
+                if (boundary != 0 && *num_pages > 0 && page % boundary == 0) {
+                    break;
+                }
+                uint64_t mask = uint64_t{1} << (bit_index % 64);
+                if ((words[bit_index / 64] & mask) == 0) {
+                    break;
+                }
+                words[bit_index / 64] &= ~mask;
+                bit_index++;
+                (*num_pages)++;
+            }
+            header_.free_counts[index] -= *num_pages;
+            header_dirty_ = true;
+            search_hint_ = index;
+
+            // Persist the allocation before the pages are used (see class comment).
+            // Synced, so the bit survives power loss and not just a process crash.
+            WriteBitmapPage(index);
+            if (fdatasync(fd_) != 0) {
+                throw std::runtime_error("Failed to sync allocation bitmap file: " + file_name_);
+            }
+
+            return static_cast<page_id_t>(index * PAGES_PER_BITMAP_PAGE + first);
+        }
+
+        // The count was stale (a crash after an allocation); repair it
+        header_.free_counts[index] = 0;
+        header_dirty_ = true;
+    }
+
+    search_hint_ = header_.num_bitmap_pages;
+    return INVALID_PAGE_ID;
+}
+
+bool AllocationBitmap::MarkFree(page_id_t page_id) {
+    if (page_id < 0 || page_id >= MAX_TRACKED_PAGES) {
+        return false;
+    }
+    uint32_t index = static_cast<uint32_t>(page_id) / PAGES_PER_BITMAP_PAGE;
+    if (index >= MAX_BITMAP_PAGES) {
+        return false;
+    }
+
+    if (index >= header_.num_bitmap_pages) {
+        // Grow: new bitmap pages start empty and are written on the next flush
+        for (uint32_t i = header_.num_bitmap_pages; i <= index; i++) {
+            bitmap_pages_.emplace_back();
+            bitmap_pages_[i].words.reset(new uint64_t[WORDS_PER_BITMAP_PAGE]());
+            bitmap_pages_[i].dirty = true;
+            header_.free_counts[i] = 0;
+        }
+        header_.num_bitmap_pages = index + 1;
+        header_dirty_ = true;
+    }
+
+    uint32_t bit_index = static_cast<uint32_t>(page_id) % PAGES_PER_BITMAP_PAGE;
+    uint64_t mask = uint64_t{1} << (bit_index % 64);
+    uint64_t *words = LoadBitmapPage(index);
+    if ((words[bit_index / 64] & mask) != 0) {
+        return true; // Already free
+    }
+
+    words[bit_index / 64] |= mask;
+    bitmap_pages_[index].dirty = true;
+    header_.free_counts[index]++;
+    header_dirty_ = true;
+    if (index < search_hint_) {
+        search_hint_ = index;
+    }
+    return true;
+}
+
+bool AllocationBitmap::IsFree(page_id_t page_id) {
+    if (page_id < 0 || page_id >= MAX_TRACKED_PAGES) {
+        return false;
+    }
+    uint32_t index = static_cast<uint32_t>(page_id) / PAGES_PER_BITMAP_PAGE;
+    if (index >= header_.num_bitmap_pages || header_.free_counts[index] == 0) {
+        return false;
+    }
+    uint32_t bit_index = static_cast<uint32_t>(page_id) % PAGES_PER_BITMAP_PAGE;
+    return (LoadBitmapPage(index)[bit_index / 64] & (uint64_t{1} << (bit_index % 64))) != 0;
+}
+
+void AllocationBitmap::Flush() {
+    bool wrote = false;
+    for (uint32_t index = 0; index < bitmap_pages_.size(); index++) {
+        if (bitmap_pages_[index].dirty) {
+            WriteBitmapPage(index);
+            wrote = true;
+        }
+    }
+    // Header last, so its free counts never claim frees that are not on disk yet
+    if (header_dirty_) {
+        WriteHeader();
+        wrote = true;
+    }
+    if (wrote && fdatasync(fd_) != 0) {
+        throw std::runtime_error("Failed to sync allocation bitmap file: " + file_name_);
+    }
+}
+
+uint64_t AllocationBitmap::GetFreeCount() const {
+    uint64_t total = 0;
+    for (uint32_t index = 0; index < header_.num_bitmap_pages; index++) {
+        total += header_.free_counts[index];
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,322 @@
+#include "storage/disk/compressed_page_store.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include "storage/compression/lz4_codec.h"
+
+namespace dbengine {
+
+static constexpr uint32_t PAGE_MAP_MAGIC = 0x50474D50; // "PGMP"
+static constexpr uint32_t PAGE_MAP_VERSION = 1;
+
+// First page of the map file; entry chunks follow, one page each
+struct PageMapHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t num_entries;
+};
+
+// Prefix of every compressed block (raw blocks are the bare page)
+struct CompressedBlockHeader {
+    uint32_t compressed_size;
+    uint32_t reserved;
+};
+
+static constexpr size_t MAX_COMPRESSED_PAYLOAD =
+    PAGE_SIZE - CompressedPageStore::SECTOR_SIZE - sizeof(CompressedBlockHeader);
+
+static uint16_t SectorsFor(size_t length) {
+    return static_cast<uint16_t>((length + CompressedPageStore::SECTOR_SIZE - 1) / CompressedPageStore::SECTOR_SIZE);
+}
+
+static bool PwriteFull(int fd, const char *data, size_t length, uint64_t offset) {
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = pwrite(fd, data + done, length - done, offset + done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Reads past the end of the file return zeros
+static bool PreadFull(int fd, char *data, size_t length, uint64_t offset) {
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = pread(fd, data + done, length - done, offset + done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            return false;
+        }
+        if (n == 0) {
+            memset(data + done, 0, length - done);
+            break;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+CompressedPageStore::CompressedPageStore(int data_fd, const std::string &map_file_name, bool reset)
+    : data_fd_(data_fd), map_fd_(-1), map_file_name_(map_file_name), map_grew_(false),
+      free_blocks_(MAX_SECTORS + 1), end_sector_(0) {
+    int flags = O_RDWR | O_CREAT | (reset ? O_TRUNC : 0);
+    map_fd_ = open(map_file_name_.c_str(), flags, 0644);
+    if (map_fd_ < 0) {
+        throw std::runtime_error("Failed to open page map file: " + map_file_name_);
+    }
+
+    PageMapHeader header;
+    if (!PreadFull(map_fd_, reinterpret_cast<char *>(&header), sizeof(header), 0)) {
+        close(map_fd_);
+        throw std::runtime_error("Failed to read page map header: " + map_file_name_);
+    }
+
+    if (header.magic != PAGE_MAP_MAGIC) {
+        // New map: the data file holds no pages yet
+        map_grew_ = true;
+        return;
+    }
+    if (header.version != PAGE_MAP_VERSION) {
+        close(map_fd_);
+        throw std::runtime_error("Unsupported page map file: " + map_file_name_);
+    }
+
+    entries_.resize(header.num_entries);
+    dirty_chunks_.resize((entries_.size() + ENTRIES_PER_MAP_PAGE - 1) / ENTRIES_PER_MAP_PAGE, false);
+    for (size_t chunk = 0; chunk < dirty_chunks_.size(); chunk++) {
+        size_t first = chunk * ENTRIES_PER_MAP_PAGE;
+        size_t count = std::min<size_t>(ENTRIES_PER_MAP_PAGE, entries_.size() - first);
+        if (!PreadFull(map_fd_, reinterpret_cast<char *>(&entries_[first]), count * sizeof(PageMapEntry),
+                       (chunk + 1) * static_cast<uint64_t>(PAGE_SIZE))) {
+            close(map_fd_);
+            throw std::runtime_error("Failed to read page map: " + map_file_name_);
+        }
+    }
+
+    RebuildFreeSpace();
+}
+
+CompressedPageStore::~CompressedPageStore() {
+    try {
+        Flush();
+    } catch (...) {
+        // Nothing sensible to do in a destructor; the last flushed map stays valid
+    }
+    close(map_fd_);
+}
+
+void CompressedPageStore::RebuildFreeSpace() {
+    // Every sector not covered by a block is free
+    std::vector<std::pair<uint64_t, uint16_t>> blocks;
+    for (const auto &entry : entries_) {
+        if (entry.capacity > 0) {
+            blocks.emplace_back(entry.sector, entry.capacity);
+        }
+    }
+    std::sort(blocks.begin(), blocks.end());
+
+    uint64_t cursor = 0;
+    for (const auto &block : blocks) {
+        if (block.first > cursor) {
+            AddFreeSpace(cursor, block.first - cursor);
+        }
+        cursor = std::max(cursor, block.first + block.second);
+    }
+    end_sector_ = cursor;
+}
+
+void CompressedPageStore::AddFreeSpace(uint64_t sector, uint64_t num_sectors) {
+    while (num_sectors > 0) {
+        uint64_t piece = std::min<uint64_t>(num_sectors, MAX_SECTORS);
+        free_blocks_[piece].push_back(sector);
+        sector += piece;
+        num_sectors -= piece;
+    }
+}
+
+uint64_t CompressedPageStore::AllocateBlock(uint16_t sectors) {
+    // Exact fit first, then split the smallest larger block
+    for (uint32_t size = sectors; size <= MAX_SECTORS; size++) {
+        if (free_blocks_[size].empty()) {
+            continue;
+        }
+        uint64_t sector = free_blocks_[size].back();
+        free_blocks_[size].pop_back();
+        if (size > sectors) {
+            free_blocks_[size - sectors].push_back(sector + sectors);
+        }
+        return sector;
+    }
+
+    uint64_t sector = end_sector_;
+    end_sector_ += sectors;
+    return sector;
+}
+
+void CompressedPageStore::WriteBlock(uint64_t sector, const char *data, size_t length) {
+    if (!PwriteFull(data_fd_, data, length, sector * SECTOR_SIZE)) {
+        throw std::runtime_error("Failed to write compressed page to database file");
+    }
+}
+
+void CompressedPageStore::ReadBlock(uint64_t sector, char *data, size_t length) {
+    if (!PreadFull(data_fd_, data, length, sector * SECTOR_SIZE)) {
+        throw std::runtime_error("Failed to read compressed page from database file");
+    }
+}
+
+void CompressedPageStore::WritePage(page_id_t page_id, const char *page_data) {
+    if (page_id < 0) {
+        throw std::out_of_range("Page ID out of range: " + std::to_string(page_id));
+    }
+    if (static_cast<size_t>(page_id) >= entries_.size()) {
+        entries_.resize(static_cast<size_t>(page_id) + 1, PageMapEntry{0, 0, 0, 0});
+        dirty_chunks_.resize((entries_.size() + ENTRIES_PER_MAP_PAGE - 1) / ENTRIES_PER_MAP_PAGE, false);
+        map_grew_ = true;
+    }
+
+    // Block image, padded with zeros to whole sectors
+    alignas(8) char block[PAGE_SIZE];
+    size_t compressed = Lz4Codec::Compress(page_data, PAGE_SIZE, block + sizeof(CompressedBlockHeader),
+                                           MAX_COMPRESSED_PAYLOAD);
+    uint16_t flags = 0;
+    size_t length;
+    if (compressed > 0) {
+        CompressedBlockHeader header{static_cast<uint32_t>(compressed), 0};
+        memcpy(block, &header, sizeof(header));
+        length = sizeof(header) + compressed;
+        size_t padded = static_cast<size_t>(SectorsFor(length)) * SECTOR_SIZE;
+        memset(block + length, 0, padded - length);
+    } else {
+        // Incompressible: store the page as-is
+        memcpy(block, page_data, PAGE_SIZE);
+        length = PAGE_SIZE;
+        flags = PAGE_MAP_RAW;
+    }
+    uint16_t sectors = SectorsFor(length);
+
+    PageMapEntry &entry = entries_[page_id];
+    bool fits_in_place = entry.capacity > 0 && entry.flags == flags && sectors <= entry.capacity;
+    if (!fits_in_place) {
+        if (entry.capacity > 0) {
+            pending_free_.emplace_back(entry.sector, entry.capacity);
+        }
+        entry.sector = AllocateBlock(sectors);
+        entry.capacity = sectors;
+        entry.flags = flags;
+    }
+    entry.stored_size = static_cast<uint32_t>(length);
+    dirty_chunks_[static_cast<size_t>(page_id) / ENTRIES_PER_MAP_PAGE] = true;
+
+    WriteBlock(entry.sector, block, static_cast<size_t>(sectors) * SECTOR_SIZE);
+}
+
+void CompressedPageStore::ReadPage(page_id_t page_id, char *page_data) {
+    if (page_id < 0 || static_cast<size_t>(page_id) >= entries_.size() || entries_[page_id].capacity == 0) {
+        // Allocated but never written
+        memset(page_data, 0, PAGE_SIZE);
+        return;
+    }
+
+    const PageMapEntry &entry = entries_[page_id];
+    if (entry.flags & PAGE_MAP_RAW) {
+        ReadBlock(entry.sector, page_data, PAGE_SIZE);
+        return;
+    }
+
+    alignas(8) char block[PAGE_SIZE];
+    size_t block_size = static_cast<size_t>(entry.capacity) * SECTOR_SIZE;
+    ReadBlock(entry.sector, block, block_size);
+
+    CompressedBlockHeader header;
+    memcpy(&header, block, sizeof(header));
+    if (header.compressed_size > block_size - sizeof(header) ||
+        Lz4Codec::Decompress(block + sizeof(header), header.compressed_size, page_data, PAGE_SIZE) != PAGE_SIZE) {
+        throw std::runtime_error("Corrupt compressed page " + std::to_string(page_id));
+    }
+}
+
+void CompressedPageStore::ReleasePage(page_id_t page_id) {
+    if (page_id < 0 || static_cast<size_t>(page_id) >= entries_.size()) {
+        return;
+    }
+    PageMapEntry &entry = entries_[page_id];
+    if (entry.capacity == 0) {
+        return;
+    }
+    pending_free_.emplace_back(entry.sector, entry.capacity);
+    entry = PageMapEntry{0, 0, 0, 0};
+    dirty_chunks_[static_cast<size_t>(page_id) / ENTRIES_PER_MAP_PAGE] = true;
+}
+
+void CompressedPageStore::WriteMapChunk(size_t chunk) {
+    // Unused tail entries of the last chunk are written as zeros
+    PageMapEntry page[ENTRIES_PER_MAP_PAGE] = {};
+    size_t first = chunk * ENTRIES_PER_MAP_PAGE;
+    size_t count = std::min<size_t>(ENTRIES_PER_MAP_PAGE, entries_.size() - first);
+    memcpy(page, &entries_[first], count * sizeof(PageMapEntry));
+
+    if (!PwriteFull(map_fd_, reinterpret_cast<const char *>(page), PAGE_SIZE,
+                    (chunk + 1) * static_cast<uint64_t>(PAGE_SIZE))) {
+        throw std::runtime_error("Failed to write page map: " + map_file_name_);
+    }
+}
+
+void CompressedPageStore::Flush() {
+    bool any_dirty = map_grew_ || std::find(dirty_chunks_.begin(), dirty_chunks_.end(), true) != dirty_chunks_.end();
+    if (!any_dirty) {
+        return;
+    }
+
+    // Blocks must be durable before the map points at them
+    if (fdatasync(data_fd_) != 0) {
+        throw std::runtime_error("Failed to sync database file before page map: " + map_file_name_);
+    }
+
+    for (size_t chunk = 0; chunk < dirty_chunks_.size(); chunk++) {
+        if (dirty_chunks_[chunk]) {
+            WriteMapChunk(chunk);
+            dirty_chunks_[chunk] = false;
+        }
+    }
+
+    if (map_grew_) {
+        PageMapHeader header{PAGE_MAP_MAGIC, PAGE_MAP_VERSION, static_cast<uint64_t>(entries_.size())};
+        if (!PwriteFull(map_fd_, reinterpret_cast<const char *>(&header), sizeof(header), 0)) {
+            throw std::runtime_error("Failed to write page map header: " + map_file_name_);
+        }
+        map_grew_ = false;
+    }
+
+    if (fdatasync(map_fd_) != 0) {
+        throw std::runtime_error("Failed to sync page map: " + map_file_name_);
+    }
+
+    // The map on disk no longer references these blocks
+    for (const auto &block : pending_free_) {
+        AddFreeSpace(block.first, block.second);
+    }
+    pending_free_.clear();
+}
+
+uint64_t CompressedPageStore::GetStoredBytes() const {
+    uint64_t total = 0;
+    for (const auto &entry : entries_) {
+        total += static_cast<uint64_t>(entry.capacity) * SECTOR_SIZE;
+    }
+    return total;
+}
+
+}
@@ -1,79 +1,496 @@
 #include "storage/disk/disk_manager.h" // Your header file
-#include <iostream> // For error messages
+#include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <cstring> // For memset (optional, to-zero-out buffers)
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
 
 
 namespace dbengine {
-DiskManager::DiskManager(const std::string &db_file): file_name_(db_file), num_pages_(0) {
-    std::ifstream check_file(file_name_);
-    if (!check_file.good()) {
-        std::ofstream create_file(file_name_, std::ios::binary);
-        if (!create_file.is_open()) {
-            throw std::runtime_error("Failed to create database file: " + file_name_);
+
+// Maximum number of requests the I/O engine keeps in flight
+static constexpr size_t IO_QUEUE_DEPTH = 64;
+
+// Staging buffer for unaligned single-page I/O in direct mode
+static char *BounceBuffer() {
+    alignas(PAGE_SIZE) static thread_local char buffer[PAGE_SIZE];
+    return buffer;
+}
+
+static bool IsAligned(const char *data) {
+    return reinterpret_cast<uintptr_t>(data) % PAGE_SIZE == 0;
+}
+
+DiskManager::DiskManager(const std::string &db_file, const DiskManagerOptions &options)
+    : direct_io_(false), read_only_(options.read_only_mmap), mapped_data_(nullptr), mapped_size_(0),
+      file_name_(db_file), num_pages_(0) {
+    if (options.compression && (options.direct_io || options.read_only_mmap)) {
+        throw std::invalid_argument("Compression cannot be combined with direct I/O or read-only mapping: " + file_name_);
+    }
+    if (!options.tablespace_files.empty() && (options.compression || options.read_only_mmap)) {
+        throw std::invalid_argument("Multi-file tablespaces cannot be compressed or mapped: " + file_name_);
+    }
+
+    if (read_only_) {
+        OpenReadOnlyMapped();
+        files_[0].io_engine = IOEngine::Create(options.io_engine, IO_QUEUE_DEPTH);
+        return;
+    }
+
+    uint64_t total_size = 0;
+    try {
+        OpenDataFile(file_name_, options.direct_io);
+        for (const auto &name : options.tablespace_files) {
+            OpenDataFile(name, options.direct_io);
+        }
+
+        // The tablespace ends after the highest page any file holds
+        for (size_t file = 0; file < files_.size(); file++) {
+            struct stat file_stat;
+            if (fstat(files_[file].fd, &file_stat) != 0) {
+                throw std::runtime_error("Failed to stat database file: " + files_[file].name);
+            }
+            total_size += static_cast<uint64_t>(file_stat.st_size);
+            uint64_t local_pages = static_cast<uint64_t>(file_stat.st_size) / PAGE_SIZE;
+            if (local_pages == 0) {
+                continue;
+            }
+            uint64_t last = local_pages - 1;
+            uint64_t stripe = (last / TABLESPACE_STRIPE_PAGES) * files_.size() + file;
+            page_id_t end = static_cast<page_id_t>(stripe * TABLESPACE_STRIPE_PAGES + last % TABLESPACE_STRIPE_PAGES + 1);
+            num_pages_ = std::max(num_pages_.load(), end);
+        }
+
+        // A bitmap left behind by a previous (deleted) database file must not be trusted.
+        bool new_file = total_size == 0;
+        allocation_bitmap_ = std::make_unique<AllocationBitmap>(file_name_ + ".bitmap", new_file);
+        if (options.compression) {
+            // Page ids map to blocks anywhere in the file; the map knows how many there are
+            compressed_store_ = std::make_unique<CompressedPageStore>(files_[0].fd, file_name_ + ".pagemap", new_file);
+            num_pages_ = compressed_store_->GetNumPages();
+        }
+
+        for (auto &file : files_) {
+            file.io_engine = IOEngine::Create(options.io_engine, IO_QUEUE_DEPTH);
+        }
+    } catch (...) {
+        compressed_store_.reset();
+        allocation_bitmap_.reset();
+        CloseFiles();
+        throw;
+    }
+}
+
+void DiskManager::OpenDataFile(const std::string &name, bool direct_io) {
+    // Open the file for read and write, creating it if it does not exist.
+    int fd = -1;
+#ifdef O_DIRECT
+    if (direct_io) {
+        fd = open(name.c_str(), O_RDWR | O_CREAT | O_DIRECT, 0644);
+        // Some filesystems (e.g. tmpfs) reject O_DIRECT; fall back to buffered I/O
+        direct_io_ = direct_io_ || fd >= 0;
+    }
+#endif
+    if (fd < 0) {
+        fd = open(name.c_str(), O_RDWR | O_CREAT, 0644);
+    }
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open database file: " + name);
+    }
+    files_.push_back(DataFile{fd, name, nullptr});
+}
+
+void DiskManager::CloseFiles() {
+    for (auto &file : files_) {
+        file.io_engine.reset();
+        if (file.fd >= 0) {
+            close(file.fd);
         }
-        create_file.close();
     }
-    check_file.close();
+    files_.clear();
+}
+
+DiskManager::PageLocation DiskManager::Locate(page_id_t page_id) const {
+    // Stripe units go round-robin over the files; within a file they are packed back to back
+    uint64_t page = static_cast<uint64_t>(page_id);
+    uint64_t stripe = page / TABLESPACE_STRIPE_PAGES;
+    uint64_t local_page = (stripe / files_.size()) * TABLESPACE_STRIPE_PAGES + page % TABLESPACE_STRIPE_PAGES;
+    return PageLocation{static_cast<size_t>(stripe % files_.size()), local_page * PAGE_SIZE};
+}
 
-    // Try to open the file for read and write in binary mode.
-    db_io_.open(file_name_, std::ios::in | std::ios::out | std::ios::binary);
-    if (!db_io_.is_open()) {
+void DiskManager::OpenReadOnlyMapped() {
+    int fd = open(file_name_.c_str(), O_RDONLY);
+    if (fd < 0) {
         throw std::runtime_error("Failed to open database file: " + file_name_);
     }
 
-    // Get the number of pages in the file.
-    db_io_.seekg(0, std::ios::end);
-    uint64_t file_size_bytes = static_cast<uint64_t>(db_io_.tellg());
-    num_pages_ = file_size_bytes / PAGE_SIZE;
-    db_io_.seekg(0, std::ios::beg);
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        throw std::runtime_error("Failed to stat database file: " + file_name_);
+    }
+    num_pages_ = static_cast<page_id_t>(static_cast<uint64_t>(file_stat.st_size) / PAGE_SIZE);
+    mapped_size_ = static_cast<size_t>(num_pages_) * PAGE_SIZE;
+
+    // An empty file cannot be mapped; every fetch is then out of range anyway
+    if (mapped_size_ > 0) {
+        void *mapping = mmap(nullptr, mapped_size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Failed to map database file: " + file_name_);
+        }
+        mapped_data_ = static_cast<const char *>(mapping);
+    }
+    files_.push_back(DataFile{fd, file_name_, nullptr});
+}
+
+const char *DiskManager::GetMappedPage(page_id_t page_id) const {
+    if (!read_only_) {
+        throw std::logic_error("Database file is not memory mapped: " + file_name_);
+    }
+    if (page_id < 0 || page_id >= num_pages_) {
+        throw std::out_of_range("Page ID out of range: " + std::to_string(page_id));
+    }
+    return mapped_data_ + static_cast<uint64_t>(page_id) * PAGE_SIZE;
+}
+
+void DiskManager::CheckWritable() const {
+    if (read_only_) {
+        throw std::logic_error("Database file is opened read-only: " + file_name_);
+    }
 }
 
 DiskManager::~DiskManager() {
-    // If the file is open, flush and close it.
-    if (db_io_.is_open()) {
-        db_io_.flush();
-        db_io_.close();
+    // Stop the engines first so no request is still using a descriptor.
+    for (auto &file : files_) {
+        file.io_engine.reset();
+    }
+
+    // Persist the page map and any frees made since the last Sync().
+    compressed_store_.reset();
+    allocation_bitmap_.reset();
+
+    if (mapped_data_ != nullptr) {
+        munmap(const_cast<char *>(mapped_data_), mapped_size_);
+    }
+
+    CloseFiles();
+}
+
+void DiskManager::CheckAligned(const char *data) const {
+    if (direct_io_ && !IsAligned(data)) {
+        throw std::invalid_argument("Direct I/O requires PAGE_SIZE-aligned buffers: " + file_name_);
     }
 }
 
 void DiskManager::WritePage(page_id_t page_id, const char *page_data) {
-    // Using uint64_t for offset to avoid potential large page IDs causing overflows.
-    uint64_t offset = static_cast<uint64_t>(page_id) * PAGE_SIZE;
+    CheckWritable();
+    ScopedLatency latency(&write_latency_);
+    counters_.Add(PAGES_WRITTEN);
 
-    // Seek put position.
-    db_io_.seekp(offset, std::ios::beg);
+    if (compressed_store_) {
+        std::lock_guard<std::mutex> lock(store_latch_);
+        compressed_store_->WritePage(page_id, page_data);
+        return;
+    }
 
-    // Write the page data to the file.
-    db_io_.write(page_data, PAGE_SIZE);
+    if (page_id < 0) {
+        throw std::out_of_range("Page ID out of range: " + std::to_string(page_id));
+    }
+    PageLocation location = Locate(page_id);
+    int fd = files_[location.file].fd;
+    uint64_t offset = location.offset;
 
-    if (!db_io_) {
-        throw std::runtime_error("Failed to write page to database file: " + file_name_);
+    if (direct_io_ && !IsAligned(page_data)) {
+        memcpy(BounceBuffer(), page_data, PAGE_SIZE);
+        page_data = BounceBuffer();
     }
 
-    // Flush the file to ensure data is written to disk.
-    db_io_.flush();
+    // Positional write: no shared seek pointer, so concurrent callers don't serialize.
+    size_t written = 0;
+    while (written < PAGE_SIZE) {
+        ssize_t n = pwrite(fd, page_data + written, PAGE_SIZE - written, offset + written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            throw std::runtime_error("Failed to write page to database file: " + file_name_);
+        }
+        written += static_cast<size_t>(n);
+    }
  }
 
  void DiskManager::ReadPage(page_id_t page_id, char *page_data) {
-    if (page_id >= num_pages_) {
+    if (page_id < 0 || page_id >= num_pages_) {
         throw std::out_of_range("Page ID out of range: " + std::to_string(page_id));
     }
-    uint64_t offset = static_cast<uint64_t>(page_id) * PAGE_SIZE;
+    ScopedLatency latency(&read_latency_);
+    counters_.Add(PAGES_READ);
+    if (read_only_) {
+        memcpy(page_data, GetMappedPage(page_id), PAGE_SIZE);
+        return;
+    }
 
-    db_io_.seekg(offset, std::ios::beg);
+    if (compressed_store_) {
+        std::lock_guard<std::mutex> lock(store_latch_);
+        compressed_store_->ReadPage(page_id, page_data);
+        return;
+    }
 
-    db_io_.read(page_data, PAGE_SIZE);
+    PageLocation location = Locate(page_id);
+    int fd = files_[location.file].fd;
+    uint64_t offset = location.offset;
 
-    if (!db_io_) {
-        throw std::runtime_error("Failed to read page from database file: " + file_name_);
+    char *caller_data = page_data;
+    if (direct_io_ && !IsAligned(page_data)) {
+        page_data = BounceBuffer();
     }
+
+    size_t read = 0;
+    while (read < PAGE_SIZE) {
+        ssize_t n = pread(fd, page_data + read, PAGE_SIZE - read, offset + read);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            throw std::runtime_error("Failed to read page from database file: " + file_name_);
+        }
+        if (n == 0) {
+            break;
+        }
+        read += static_cast<size_t>(n);
+    }
+
+    // The page was allocated but never written; it reads back as zeros.
+    if (read < PAGE_SIZE) {
+        memset(page_data + read, 0, PAGE_SIZE - read);
+    }
+
+    if (page_data != caller_data) {
+        memcpy(caller_data, page_data, PAGE_SIZE);
+    }
+ }
+
+ std::shared_ptr<IOBatch> DiskManager::MakeBatch(IOType type, const std::vector<PageRequest> &requests) {
+    std::vector<IORequest> io_requests;
+    io_requests.reserve(requests.size());
+
+    for (const auto &request : requests) {
+        if (request.page_id < 0 || (type == IOType::READ && request.page_id >= num_pages_)) {
+            throw std::out_of_range("Page ID out of range: " + std::to_string(request.page_id));
+        }
+        CheckAligned(request.data);
+        PageLocation location = Locate(request.page_id);
+        int fd = files_[location.file].fd;
+
+        // The next page on disk going into the next page in memory extends the previous read
+        if (type == IOType::READ && !io_requests.empty()) {
+            IORequest &last = io_requests.back();
+            if (last.fd == fd && last.offset + last.length == location.offset &&
+                last.buffer + last.length == request.data && last.length < MAX_MERGED_PAGES * PAGE_SIZE) {
+                last.length += PAGE_SIZE;
+                continue;
+            }
+        }
+        io_requests.push_back(IORequest{type, fd, location.offset, request.data, PAGE_SIZE, 0});
+    }
+    counters_.Add(type == IOType::READ ? PAGES_READ : PAGES_WRITTEN, requests.size());
+
+    // Group the requests by file so each file's share goes to its engine in one piece
+    if (files_.size() > 1) {
+        std::stable_sort(io_requests.begin(), io_requests.end(), [](const IORequest &a, const IORequest &b) {
+            return a.fd < b.fd;
+        });
+    }
+
+    return std::make_shared<IOBatch>(std::move(io_requests));
+ }
+
+ void DiskManager::SubmitBatch(const std::shared_ptr<IOBatch> &batch) {
+    const std::vector<IORequest> &io_requests = batch->GetRequests();
+    size_t begin = 0;
+    while (begin < io_requests.size()) {
+        size_t end = begin;
+        while (end < io_requests.size() && io_requests[end].fd == io_requests[begin].fd) {
+            end++;
+        }
+        for (auto &file : files_) {
+            if (file.fd == io_requests[begin].fd) {
+                file.io_engine->Submit(batch, begin, end);
+                break;
+            }
+        }
+        begin = end;
+    }
+ }
+
+ std::shared_ptr<IOBatch> DiskManager::SubmitReadPages(const std::vector<PageRequest> &requests) {
+    if (compressed_store_) {
+        // Each block has its own size and location; decompress page by page and
+        // hand back a batch that is already complete.
+        for (const auto &request : requests) {
+            ReadPage(request.page_id, request.data);
+        }
+        return std::make_shared<IOBatch>(std::vector<IORequest>());
+    }
+    auto batch = MakeBatch(IOType::READ, requests);
+    SubmitBatch(batch);
+    return batch;
+ }
+
+ std::shared_ptr<IOBatch> DiskManager::SubmitWritePages(const std::vector<PageRequest> &requests) {
+    CheckWritable();
+    if (compressed_store_) {
+        std::lock_guard<std::mutex> lock(store_latch_);
+        for (const auto &request : requests) {
+            compressed_store_->WritePage(request.page_id, request.data);
+        }
+        counters_.Add(PAGES_WRITTEN, requests.size());
+        return std::make_shared<IOBatch>(std::vector<IORequest>());
+    }
+    auto batch = MakeBatch(IOType::WRITE, requests);
+    SubmitBatch(batch);
+    return batch;
+ }
+
+ void DiskManager::WaitForBatch(const std::shared_ptr<IOBatch> &batch) {
+    batch->Wait();
+
+    for (auto &request : batch->GetRequests()) {
+        if (request.result < 0) {
+            throw std::runtime_error(std::string("Failed to ") + (request.type == IOType::READ ? "read" : "write") +
+                                     " page in database file " + file_name_ + ": " + std::strerror(static_cast<int>(-request.result)));
+        }
+
+        size_t transferred = static_cast<size_t>(request.result);
+        if (transferred < request.length) {
+            if (request.type == IOType::WRITE) {
+                throw std::runtime_error("Short write to database file: " + file_name_);
+            }
+            // Same as ReadPage: allocated but never written pages read back as zeros.
+            memset(request.buffer + transferred, 0, request.length - transferred);
+        }
+    }
+ }
+
+ void DiskManager::ReadPages(const std::vector<PageRequest> &requests) {
+    if (requests.empty()) {
+        return;
+    }
+    WaitForBatch(SubmitReadPages(requests));
+ }
+
+ void DiskManager::WritePages(const std::vector<PageRequest> &requests) {
+    if (requests.empty()) {
+        return;
+    }
+    WaitForBatch(SubmitWritePages(requests));
+ }
+
+ void DiskManager::WritePagesCoalesced(std::vector<PageRequest> &requests) {
+    CheckWritable();
+    // File order, not page id order: consecutive stripes of one file are adjacent on disk
+    std::sort(requests.begin(), requests.end(), [this](const PageRequest &a, const PageRequest &b) {
+        PageLocation la = Locate(a.page_id);
+        PageLocation lb = Locate(b.page_id);
+        return la.file != lb.file ? la.file < lb.file : la.offset < lb.offset;
+    });
+    counters_.Add(PAGES_WRITTEN, requests.size());
+
+    if (compressed_store_) {
+        // Compressed blocks are not page-aligned, so there are no runs to merge
+        std::lock_guard<std::mutex> lock(store_latch_);
+        for (const auto &request : requests) {
+            compressed_store_->WritePage(request.page_id, request.data);
+        }
+        return;
+    }
+
+    std::vector<iovec> iovecs;
+    size_t i = 0;
+    while (i < requests.size()) {
+        // Extend the run while the next page sits right after the previous one in the same file
+        PageLocation run_start = Locate(requests[i].page_id);
+        iovecs.clear();
+        while (i < requests.size() && iovecs.size() < static_cast<size_t>(IOV_MAX)) {
+            PageLocation location = Locate(requests[i].page_id);
+            if (location.file != run_start.file || location.offset != run_start.offset + iovecs.size() * PAGE_SIZE) {
+                break;
+            }
+            CheckAligned(requests[i].data);
+            iovecs.push_back(iovec{requests[i].data, PAGE_SIZE});
+            i++;
+        }
+
+        const DataFile &file = files_[run_start.file];
+        uint64_t offset = run_start.offset;
+        size_t remaining = iovecs.size() * PAGE_SIZE;
+        iovec *iov = iovecs.data();
+        int iov_count = static_cast<int>(iovecs.size());
+
+        // pwritev may write less than asked; advance through the iovecs and retry
+        while (remaining > 0) {
+            ssize_t n = pwritev(file.fd, iov, iov_count, offset);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::runtime_error("Failed to write pages to database file: " + file.name);
+            }
+            remaining -= static_cast<size_t>(n);
+            offset += static_cast<uint64_t>(n);
+            size_t advance = static_cast<size_t>(n);
+            while (advance > 0 && advance >= iov->iov_len) {
+                advance -= iov->iov_len;
+                iov++;
+                iov_count--;
+            }
+            if (advance > 0) {
+                iov->iov_base = static_cast<char *>(iov->iov_base) + advance;
+                iov->iov_len -= advance;
+            }
+        }
+    }
+ }
+
+ void DiskManager::Sync() {
+    if (read_only_) {
+        return; // Nothing can be dirty
+    }
+    counters_.Add(SYNCS);
+    if (compressed_store_) {
+        // Syncs the data file, then the page map
+        std::lock_guard<std::mutex> lock(store_latch_);
+        compressed_store_->Flush();
+    } else {
+        for (const auto &file : files_) {
+            if (fdatasync(file.fd) != 0) {
+                throw std::runtime_error("Failed to sync database file: " + file.name);
+            }
+        }
+    }
+    std::lock_guard<std::mutex> lock(allocation_latch_);
+    allocation_bitmap_->Flush();
  }
 
  page_id_t DiskManager::AllocatePage() {
+    CheckWritable();
+    std::lock_guard<std::mutex> lock(allocation_latch_);
+
     // First, check if we have any deallocated pages to reuse
-    if (!free_list_.empty()) {
-        page_id_t reused_page_id = free_list_.back();
-        free_list_.pop_back();
+    counters_.Add(PAGES_ALLOCATED);
+    page_id_t reused_page_id = allocation_bitmap_->AllocateFreePage();
+    if (reused_page_id != INVALID_PAGE_ID) {
+        counters_.Add(PAGES_REUSED);
+        // A page freed before a crash may lie past the end of the (unsynced) file.
+        if (reused_page_id >= num_pages_) {
+            num_pages_ = reused_page_id + 1;
+        }
         return reused_page_id;
     }
 
@@ -81,17 +498,169 @@ void DiskManager::WritePage(page_id_t page_id, const char *page_data) {
     return num_pages_++;
  }
 
+ page_id_t DiskManager::AllocatePage(PageExtent *extent) {
+    CheckWritable();
+
+    if (extent->next_page_id == INVALID_PAGE_ID || extent->next_page_id >= extent->end_page_id) {
+        // Pages freed back to the bitmap come first, so the file only grows when none are left
+        page_id_t start;
+        uint32_t num_pages;
+        {
+            std::lock_guard<std::mutex> lock(allocation_latch_);
+            // Across files, a reused run stops at a stripe boundary like a new extent does
+            uint32_t boundary = files_.size() > 1 ? TABLESPACE_STRIPE_PAGES : 0;
+            start = allocation_bitmap_->AllocateFreeRun(EXTENT_SIZE, &num_pages, boundary);
+            // A page freed before a crash may lie past the end of the (unsynced) file.
+            if (start != INVALID_PAGE_ID && start + static_cast<page_id_t>(num_pages) > num_pages_) {
+                num_pages_ = start + static_cast<page_id_t>(num_pages);
+            }
+        }
+        if (start != INVALID_PAGE_ID) {
+            counters_.Add(PAGES_REUSED, num_pages);
+        } else {
+            start = AllocateExtent(EXTENT_SIZE);
+            num_pages = EXTENT_SIZE;
+        }
+        extent->next_page_id = start;
+        extent->end_page_id = start + static_cast<page_id_t>(num_pages);
+    }
+
+    counters_.Add(PAGES_ALLOCATED);
+    return extent->next_page_id++;
+ }
+
+ void DiskManager::ReleaseExtent(PageExtent *extent) {
+    page_id_t next_page_id = extent->next_page_id;
+    page_id_t end_page_id = extent->end_page_id;
+    extent->next_page_id = INVALID_PAGE_ID;
+    extent->end_page_id = INVALID_PAGE_ID;
+    if (next_page_id == INVALID_PAGE_ID || next_page_id >= end_page_id) {
+        return;
+    }
+
+    CheckWritable();
+    std::lock_guard<std::mutex> lock(allocation_latch_);
+    try {
+        for (page_id_t page_id = next_page_id; page_id < end_page_id; page_id++) {
+            allocation_bitmap_->MarkFree(page_id);
+        }
+    } catch (const std::exception &) {
+        // Owners release their extent on destruction; a page that cannot be recorded is only leaked
+    }
+ }
+
+ page_id_t DiskManager::AllocateExtent(uint32_t num_pages) {
+    CheckWritable();
+
+    // Claim the range; the extent is the caller's alone from here on
+    page_id_t start;
+    {
+        std::lock_guard<std::mutex> lock(allocation_latch_);
+        start = num_pages_;
+        if (files_.size() > 1 && start % TABLESPACE_STRIPE_PAGES != 0) {
+            // Single-page allocations leave the end off a stripe boundary. Start the extent on
+            // the next one so it stays in one file, and let the skipped pages be reused.
+            page_id_t aligned = (start / TABLESPACE_STRIPE_PAGES + 1) * TABLESPACE_STRIPE_PAGES;
+            try {
+                for (page_id_t page_id = start; page_id < aligned; page_id++) {
+                    allocation_bitmap_->MarkFree(page_id);
+                }
+            } catch (const std::exception &) {
+                // A skipped page that cannot be recorded is only leaked
+            }
+            start = aligned;
+        }
+        num_pages_ = start + static_cast<page_id_t>(num_pages);
+    }
+    counters_.Add(EXTENTS_ALLOCATED);
+    page_id_t end = start + static_cast<page_id_t>(num_pages);
+
+    // Reserve the blocks now so the extent is contiguous on disk. Best effort: if the
+    // filesystem can't preallocate, the pages still read back as zeros until written.
+#ifdef __linux__
+    if (compressed_store_) {
+        // Compressed blocks are placed by the page map, not by page id
+        return start;
+    }
+    // One fallocate per stripe unit piece: an extent longer than a stripe unit crosses files
+    page_id_t page_id = start;
+    while (page_id < end) {
+        uint64_t stripe_left = TABLESPACE_STRIPE_PAGES - static_cast<uint64_t>(page_id) % TABLESPACE_STRIPE_PAGES;
+        uint64_t run = std::min<uint64_t>(stripe_left, static_cast<uint64_t>(end - page_id));
+        PageLocation location = Locate(page_id);
+        off_t length = static_cast<off_t>(run * PAGE_SIZE);
+        while (fallocate(files_[location.file].fd, 0, static_cast<off_t>(location.offset), length) != 0 && errno == EINTR) {
+        }
+        page_id += static_cast<page_id_t>(run);
+    }
+#endif
+
+    return start;
+ }
+
  void DiskManager::DeallocatePage(page_id_t page_id) {
+    CheckWritable();
+
     // Validate the page_id
     if (page_id < 0 || page_id >= num_pages_) {
         // Invalid page_id, ignore the request
         return;
     }
 
-    // Add the page to the free list for future reuse
-    free_list_.push_back(page_id);
+    counters_.Add(PAGES_DEALLOCATED);
+
+    // Record the page as free; persisted on the next Sync() or at shutdown
+    {
+        std::lock_guard<std::mutex> lock(allocation_latch_);
+        allocation_bitmap_->MarkFree(page_id);
+    }
+
+    // The compressed block can be reused once the page map is synced
+    if (compressed_store_) {
+        std::lock_guard<std::mutex> lock(store_latch_);
+        compressed_store_->ReleasePage(page_id);
+    }
 
     // Note: We don't actually zero out the page data on disk
     // The page will be overwritten when it's reused by AllocatePage
  }
-}
\ No newline at end of file
+ uint64_t DiskManager::GetNumFreePages() const {
+    if (!allocation_bitmap_) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(allocation_latch_);
+    return allocation_bitmap_->GetFreeCount();
+ }
+ uint64_t DiskManager::GetStoredBytes() const {
+    if (compressed_store_) {
+        std::lock_guard<std::mutex> lock(store_latch_);
+        return compressed_store_->GetStoredBytes();
+    }
+    return static_cast<uint64_t>(num_pages_) * PAGE_SIZE;
+ }
+ DiskStats DiskManager::GetStats() const {
+    DiskStats stats;
+    stats.pages_read = counters_.Get(PAGES_READ);
+    stats.pages_written = counters_.Get(PAGES_WRITTEN);
+    stats.pages_allocated = counters_.Get(PAGES_ALLOCATED);
+    stats.pages_reused = counters_.Get(PAGES_REUSED);
+    stats.extents_allocated = counters_.Get(EXTENTS_ALLOCATED);
+    stats.pages_deallocated = counters_.Get(PAGES_DEALLOCATED);
+    stats.syncs = counters_.Get(SYNCS);
+    stats.read_latency = read_latency_.Snapshot();
+    stats.write_latency = write_latency_.Snapshot();
+    return stats;
+ }
+
+ std::string DiskStats::ToString() const {
+    return "pages_read " + std::to_string(pages_read) + "\n" +
+           "pages_written " + std::to_string(pages_written) + "\n" +
+           "pages_allocated " + std::to_string(pages_allocated) + "\n" +
+           "pages_reused " + std::to_string(pages_reused) + "\n" +
+           "extents_allocated " + std::to_string(extents_allocated) + "\n" +
+           "pages_deallocated " + std::to_string(pages_deallocated) + "\n" +
+           "syncs " + std::to_string(syncs) + "\n" +
+           "read_latency " + read_latency.ToString() + "\n" +
+           "write_latency " + write_latency.ToString() + "\n";
+ }
+}
@@ -0,0 +1,130 @@
+#include "storage/disk/io_engine.h"
+
+#include <cerrno>
+#include <algorithm>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace dbengine {
+
+IOBatch::IOBatch(std::vector<IORequest> requests) : requests_(std::move(requests)), pending_(requests_.size()) {
+    for (auto &request : requests_) {
+        request.result = 0;
+    }
+}
+
+void IOBatch::Wait() {
+    std::unique_lock<std::mutex> lock(latch_);
+    cv_.wait(lock, [this] { return pending_ == 0; });
+}
+
+bool IOBatch::IsComplete() {
+    std::lock_guard<std::mutex> lock(latch_);
+    return pending_ == 0;
+}
+
+void IOBatch::CompleteRequest(size_t index, ssize_t result) {
+    std::lock_guard<std::mutex> lock(latch_);
+    requests_[index].result = result;
+    if (--pending_ == 0) {
+        cv_.notify_all();
+    }
+}
+
+// Issue a request with pread/pwrite, retrying until it is fully transferred.
+// Reads stop early at end of file; the short count is reported to the caller.
+static ssize_t ExecuteRequest(const IORequest &request) {
+    size_t done = 0;
+    while (done < request.length) {
+        ssize_t n;
+        if (request.type == IOType::READ) {
+            n = pread(request.fd, request.buffer + done, request.length - done, request.offset + done);
+        } else {
+            n = pwrite(request.fd, request.buffer + done, request.length - done, request.offset + done);
+        }
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -errno;
+        }
+        if (n == 0) {
+            break; // End of file
+        }
+        done += static_cast<size_t>(n);
+    }
+    return static_cast<ssize_t>(done);
+}
+
+ThreadPoolIOEngine::ThreadPoolIOEngine(size_t num_threads) : shutdown_(false) {
+    if (num_threads == 0) {
+        num_threads = 1;
+    }
+    for (size_t i = 0; i < num_threads; i++) {
+        workers_.emplace_back(&ThreadPoolIOEngine::WorkerLoop, this);
+    }
+}
+
+ThreadPoolIOEngine::~ThreadPoolIOEngine() {
+    {
+        std::lock_guard<std::mutex> lock(latch_);
+        shutdown_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPoolIOEngine::Submit(const std::shared_ptr<IOBatch> &batch, size_t begin, size_t end) {
+    {
+        std::lock_guard<std::mutex> lock(latch_);
+        for (size_t i = begin; i < end; i++) {
+            queue_.push_back(Task{batch, i});
+        }
+    }
+    cv_.notify_all();
+}
+
+void ThreadPoolIOEngine::WorkerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(latch_);
+            cv_.wait(lock, [this] { return shutdown_ || !queue_.empty(); });
+
+            // Drain outstanding work before exiting so no batch is left waiting
+            if (queue_.empty()) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        const IORequest &request = task.batch->GetRequests()[task.index];
+        task.batch->CompleteRequest(task.index, ExecuteRequest(request));
+    }
+}
+
+std::unique_ptr<IOEngine> IOEngine::Create(IOEngineType type, size_t queue_depth) {
+    // Enough workers to keep a handful of requests in flight without oversubscribing
+    size_t num_threads = std::min<size_t>(queue_depth, 8);
+
+    if (type == IOEngineType::THREAD_POOL) {
+        return std::make_unique<ThreadPoolIOEngine>(num_threads);
+    }
+
+    try {
+        return std::make_unique<IoUringIOEngine>(queue_depth);
+    } catch (const std::runtime_error &e) {
+        if (type == IOEngineType::IO_URING) {
+            throw;
+        }
+        // AUTO: io_uring may be compiled out, unsupported by the kernel, too old for
+        // IORING_OP_READ/WRITE or blocked by seccomp
+        return std::make_unique<ThreadPoolIOEngine>(num_threads);
+    }
+}
+
+}
@@ -4,11 +4,20 @@
 #include <cstring>
 #include <algorithm>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 namespace dbengine {
-    BPlusTree::BPlusTree(BufferPoolManager *bpm, uint32_t max_size) : bpm_(bpm), max_size_(max_size) {
+    BPlusTree::BPlusTree(BufferPool *bpm, uint32_t max_size) : bpm_(bpm), max_size_(max_size) {
 
-        Page *root_page = bpm_->NewPage(&root_page_id_);
+        // Node arrays must end before the page checksum trailer
+        size_t leaf_bytes = BPlusTreeLeafPage::RidsOffset(max_size_) + max_size_ * sizeof(RID);
+        size_t internal_bytes = BPlusTreeInternalPage::ChildrenOffset(max_size_) + (max_size_ + 1) * sizeof(page_id_t);
+        if (leaf_bytes > PAGE_CHECKSUM_OFFSET || internal_bytes > PAGE_CHECKSUM_OFFSET) {
+            throw std::invalid_argument("B+ tree max_size does not fit in a page: " + std::to_string(max_size_));
+        }
+
+        Page *root_page = bpm_->NewPage(&root_page_id_, &extent_);
 
         if (root_page == nullptr) {
             throw std::runtime_error("Failed to allocate root page for B+ tree");
@@ -29,6 +38,10 @@ namespace dbengine {
 
     }
 
+    BPlusTree::~BPlusTree() {
+        bpm_->ReleaseExtent(&extent_);
+    }
+
     Page* BPlusTree::FindLeaf(int32_t key) {
         page_id_t current_page_id = root_page_id_;
 
@@ -134,7 +147,7 @@ namespace dbengine {
             BPlusTreeLeafPage leaf_page(page_data, max_size_);
 
             page_id_t new_page_id;
-            Page *new_page = bpm_->NewPage(&new_page_id);
+            Page *new_page = bpm_->NewPage(&new_page_id, &extent_);
             if (new_page == nullptr) {
                 bpm_->UnpinPage(page_id, false);
                 return false;
@@ -188,7 +201,7 @@ namespace dbengine {
             BPlusTreeInternalPage internal_page(page_data, max_size_);
 
             page_id_t new_page_id;
-            Page *new_page = bpm_->NewPage(&new_page_id);
+            Page *new_page = bpm_->NewPage(&new_page_id, &extent_);
             if (new_page == nullptr) {
                 bpm_->UnpinPage(page_id, false);
                 return false;
@@ -247,7 +260,7 @@ namespace dbengine {
     }
 
     bool BPlusTree::CreateNewRoot(page_id_t left_page_id, page_id_t right_page_id, int32_t key) {
-        Page *root_page = bpm_->NewPage(&root_page_id_);
+        Page *root_page = bpm_->NewPage(&root_page_id_, &extent_);
         if (root_page == nullptr) {
             return false;
         }
@@ -4,7 +4,7 @@
 
 namespace dbengine {
 
-    void Page::Init(int32_t page_id) {
+    void Page::Init(page_id_t page_id) {
         // Zero out all the page data
         memset(data_, 0, PAGE_SIZE);
 
@@ -12,11 +12,13 @@ namespace dbengine {
         PageHeader *header = GetHeader();
         header->num_slots = 0;
         header->num_records = 0;
-        header->free_space_pointer = PAGE_SIZE;
+        header->free_space_pointer = PAGE_CHECKSUM_OFFSET; // Records end before the checksum trailer
         header->page_id = page_id;
+        header->next_page_id = INVALID_PAGE_ID;
+        header->free_slot_head = INVALID_SLOT_NUM;
     }
     
-    int32_t Page::GetPageId() const {
+    page_id_t Page::GetPageId() const {
         return GetHeader()->page_id;
     }
 
@@ -35,32 +37,87 @@ namespace dbengine {
         return 0;
      }
 
-      bool Page::InsertRecord(const char *data, uint32_t size, RID &rid) {
-            PageHeader *header = GetHeader();
+     uint32_t Page::GetLiveBytes() const {
+        const PageHeader *header = GetHeader();
+        uint32_t live_bytes = 0;
+        for (uint32_t i = 0; i < header->num_slots; i++) {
+            live_bytes += GetSlot(i)->size;
+        }
+        return live_bytes;
+     }
 
-            // Calculate space needed
-            uint32_t slot_array_end = sizeof(PageHeader) + ((header->num_slots + 1) * sizeof(Slot));
+     uint32_t Page::GetReclaimableSpace() const {
+        // Records occupy [free_space_pointer, PAGE_CHECKSUM_OFFSET); what isn't live is dead
+        return PAGE_CHECKSUM_OFFSET - GetHeader()->free_space_pointer - GetLiveBytes();
+     }
 
-            uint32_t space_needed = size;
+     void Page::Compact() {
+        PageHeader *header = GetHeader();
 
-            // Need space for new slot AND the record
-            if (header->free_space_pointer - space_needed < slot_array_end) {
-                return false;
+        // Live slots, highest offset first: each record then slides towards the end of
+        // the page without overwriting one that hasn't moved yet
+        uint32_t live[PAGE_SIZE / sizeof(Slot)];
+        uint32_t num_live = 0;
+        for (uint32_t i = 0; i < header->num_slots; i++) {
+            if (GetSlot(i)->size > 0) {
+                live[num_live++] = i;
+            }
+        }
+        std::sort(live, live + num_live, [this](uint32_t a, uint32_t b) {
+            return GetSlot(a)->offset > GetSlot(b)->offset;
+        });
+
+        uint32_t records_start = PAGE_CHECKSUM_OFFSET;
+        for (uint32_t i = 0; i < num_live; i++) {
+            Slot *slot = GetSlot(live[i]);
+            records_start -= slot->size;
+            if (slot->offset != records_start) {
+                memmove(data_ + records_start, data_ + slot->offset, slot->size);
+                slot->offset = records_start;
             }
+        }
+        header->free_space_pointer = records_start;
+     }
 
-            // Find an empty slot (deleted record) to reuse, or create a new one
+     bool Page::MakeRoom(uint32_t size, uint32_t slot_array_end) {
+        PageHeader *header = GetHeader();
+        if (header->free_space_pointer >= slot_array_end && header->free_space_pointer - slot_array_end >= size) {
+            return true;
+        }
+
+        // Dead records may leave enough room once the live ones are packed together
+        uint64_t space_needed = static_cast<uint64_t>(slot_array_end) + size + GetLiveBytes();
+        if (space_needed > PAGE_CHECKSUM_OFFSET) {
+            return false;
+        }
+        Compact();
+        return true;
+     }
+
+      bool Page::InsertRecord(const char *data, uint32_t size, RID &rid) {
+            PageHeader *header = GetHeader();
+
+            // Reuse the most recently deleted slot, if any
             int32_t slot_num = -1;
-            for (uint32_t i = 0; i < header->num_slots; i++) {
-                Slot *slot = GetSlot(i);
-                if (slot->size == 0) { // Deleted slot, reuse it
-                    slot_num = static_cast<int32_t>(i);
-                    slot->generation++;
-                    break;
-                }
+            if (header->free_slot_head != INVALID_SLOT_NUM) {
+                slot_num = static_cast<int32_t>(header->free_slot_head);
+            }
+
+            // Need space for the record, and for a new slot if none is reused
+            uint32_t new_slots = slot_num == -1 ? 1 : 0;
+            uint32_t slot_array_end = sizeof(PageHeader) + ((header->num_slots + new_slots) * sizeof(Slot));
+            if (!MakeRoom(size, slot_array_end)) {
+                return false;
             }
 
-            // If no empty slot found, create a new one
-            if (slot_num == -1) {
+            if (slot_num != -1) {
+                // Deleted slot, reuse it: unlink it from the free slot chain. The new
+                // generation makes RIDs of the deleted record stale.
+                Slot *slot = GetSlot(slot_num);
+                header->free_slot_head = slot->offset;
+                slot->generation++;
+            } else {
+                // If no empty slot found, create a new one
                 slot_num = header->num_slots;
                 header->num_slots++;
             }
@@ -86,13 +143,26 @@ namespace dbengine {
             return true;
       }
       
-      bool Page::GetRecord(const RID &rid, char *data) {
+      bool Page::GetRecord(const RID &rid, char *data) const {
+        uint32_t size;
+        const char *record = GetRecordData(rid, &size);
+        if (record == nullptr) {
+            return false;
+        }
+
+        // Copy record data to output buffer
+        memcpy(data, record, size);
+
+        return true;
+      }
+
+      const char *Page::GetRecordData(const RID &rid, uint32_t *size) const {
         const PageHeader *header = GetHeader();
 
         // Validate slot number
         int32_t slot_num = rid.GetSlotNum();
         if (slot_num < 0 || static_cast<uint32_t>(slot_num) >= header->num_slots) {
-            return false; // Invalid slot number
+            return nullptr; // Invalid slot number
         }
 
         // Get the slot
@@ -100,18 +170,16 @@ namespace dbengine {
 
         // Check if slot generation number matches the RID's generation number
         if (slot->generation != rid.GetGeneration()) {
-            return false; // Generation number mismatch
+            return nullptr; // Generation number mismatch
         }
 
         // Check if record is deleted
         if (slot->size == 0) {
-            return false; // Record was deleted
+            return nullptr; // Record was deleted
         }
 
-        // Copy record data to output buffer
-        memcpy(data, data_ + slot->offset, slot->size);
-
-        return true;
+        *size = slot->size;
+        return data_ + slot->offset;
       }
 
       /** 
@@ -138,10 +206,16 @@ namespace dbengine {
             return false; // Already deleted
         }
 
-        // Mark as deleted (set size to 0)
+        // The newest record's space goes straight back to the free space; any other
+        // record's space is reclaimed when the page is compacted
+        if (slot->offset == header->free_space_pointer) {
+            header->free_space_pointer += slot->size;
+        }
+
+        // Mark as deleted (set size to 0) and push the slot onto the free slot chain
         slot->size = 0;
-        // Note: We don't actually remove the data or reclaim space
-        // A real databse would do "compaction" to reclaim space
+        slot->offset = header->free_slot_head;
+        header->free_slot_head = static_cast<uint32_t>(slot_num);
 
         // Update header
         header->num_records--;
@@ -181,26 +255,23 @@ namespace dbengine {
             return true;
         }
 
-        // Complex case: new data is larger than the old psace
-        // For now we'll delete the old record and insert a new one'
-        // A real implementation would do compaction
-        DeleteRecord(rid);
-        RID new_rid;
-        if (InsertRecord(data, size, new_rid)) {
-            // Copy the new RID's slot to the old slot position to maintain RID
-            Slot *new_slot = GetSlot(new_rid.GetSlotNum());
-            slot->offset = new_slot->offset;
-            slot->size = new_slot->size;
-
-            // Mark the new slot as empty
-            new_slot->size = 0;
-
-            header->num_records--; // Complete for the extra increment
-
-            return true;
+        // Complex case: new data is larger than the old space. The record moves to the
+        // free space, and its old bytes become dead space; the slot keeps its number and
+        // generation, so the RID stays valid.
+        uint32_t old_size = slot->size;
+        slot->size = 0; // Not live while making room: compaction may reuse its bytes
+        uint32_t slot_array_end = sizeof(PageHeader) + (header->num_slots * sizeof(Slot));
+        if (!MakeRoom(size, slot_array_end)) {
+            slot->size = old_size; // Page untouched: the old record is still there
+            return false; // Not enough space for larger record
         }
 
-        return false; // Not enough space for larger record
-        
+        uint32_t record_offset = header->free_space_pointer - size;
+        memcpy(data_ + record_offset, data, size);
+        slot->offset = record_offset;
+        slot->size = size;
+        header->free_space_pointer = record_offset;
+
+        return true;
     }
     }
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "storage/page/page_checksum.h"
+
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#define DBENGINE_CRC32C_X86 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define DBENGINE_CRC32C_ARM 1
+#endif
+
+namespace dbengine {
+
+// Reflected CRC32C polynomial
+static constexpr uint32_t CRC32C_POLY = 0x82F63B78;
+
+namespace {
+
+    // Slicing-by-8 lookup tables, built once at startup
+    struct Crc32cTables {
+        uint32_t table[8][256];
+
+        Crc32cTables() {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; bit++) {
+                    crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+                }
+                table[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; i++) {
+                for (int slice = 1; slice < 8; slice++) {
+                    table[slice][i] = (table[slice - 1][i] >> 8) ^ table[0][table[slice - 1][i] & 0xFF];
+                }
+            }
+        }
+    };
+
+    const Crc32cTables CRC_TABLES;
+
+#ifdef DBENGINE_CRC32C_X86
+    // The crc32 instruction has 3-cycle latency but 1-cycle throughput, so a single
+    // dependency chain leaves it two-thirds idle. Long buffers are split into three
+    // lanes checksummed in parallel and then stitched together.
+    constexpr size_t LANE_BYTES = 1360;
+
+    // Advancing a CRC register over LANE_BYTES zero bytes is linear in the register,
+    // so it is tabulated per register byte: shift(c) = XOR of four lookups.
+    struct LaneShiftTables {
+        uint32_t table[4][256];
+
+        LaneShiftTables() {
+            uint32_t basis[32];
+            for (int bit = 0; bit < 32; bit++) {
+                uint32_t crc = uint32_t{1} << bit;
+                for (size_t i = 0; i < LANE_BYTES; i++) {
+                    crc = (crc >> 8) ^ CRC_TABLES.table[0][crc & 0xFF];
+                }
+                basis[bit] = crc;
+            }
+            for (int byte = 0; byte < 4; byte++) {
+                for (uint32_t value = 0; value < 256; value++) {
+                    uint32_t shifted = 0;
+                    for (int bit = 0; bit < 8; bit++) {
+                        if (value & (1u << bit)) {
+                            shifted ^= basis[byte * 8 + bit];
+                        }
+                    }
+                    table[byte][value] = shifted;
+                }
+            }
+        }
+
+        uint32_t Shift(uint32_t crc) const {
+            return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^
+                   table[2][(crc >> 16) & 0xFF] ^ table[3][crc >> 24];
+        }
+    };
+
+    const LaneShiftTables LANE_SHIFT;
+
+    __attribute__((target("sse4.2")))
+    uint32_t Crc32cHardware(const char *data, size_t length) {
+        uint64_t crc = 0xFFFFFFFF;
+
+        while (length >= 3 * LANE_BYTES) {
+            uint64_t crc1 = 0;
+            uint64_t crc2 = 0;
+            for (size_t i = 0; i < LANE_BYTES; i += 8) {
+                uint64_t w0;
+                uint64_t w1;
+                uint64_t w2;
+                std::memcpy(&w0, data + i, sizeof(w0));
+                std::memcpy(&w1, data + LANE_BYTES + i, sizeof(w1));
+                std::memcpy(&w2, data + 2 * LANE_BYTES + i, sizeof(w2));
+                crc = _mm_crc32_u64(crc, w0);
+                crc1 = _mm_crc32_u64(crc1, w1);
+                crc2 = _mm_crc32_u64(crc2, w2);
+            }
+            // crc(A||B) = shift(crc(A), |B|) ^ crc_from_zero(B)
+            uint32_t combined = LANE_SHIFT.Shift(static_cast<uint32_t>(crc)) ^ static_cast<uint32_t>(crc1);
+            combined = LANE_SHIFT.Shift(combined) ^ static_cast<uint32_t>(crc2);
+            crc = combined;
+            data += 3 * LANE_BYTES;
+            length -= 3 * LANE_BYTES;
+        }
+
+        while (length >= 8) {
+            uint64_t word;
+            std::memcpy(&word, data, sizeof(word));
+            crc = _mm_crc32_u64(crc, word);
+            data += 8;
+            length -= 8;
+        }
+        uint32_t crc32 = static_cast<uint32_t>(crc);
+        while (length > 0) {
+            crc32 = _mm_crc32_u8(crc32, static_cast<uint8_t>(*data));
+            data++;
+            length--;
+        }
+        return crc32 ^ 0xFFFFFFFF;
+    }
+
+    const bool HAS_HARDWARE_CRC = __builtin_cpu_supports("sse4.2");
+#elif defined(DBENGINE_CRC32C_ARM)
+    uint32_t Crc32cHardware(const char *data, size_t length) {
+        uint32_t crc = 0xFFFFFFFF;
+        while (length >= 8) {
+            uint64_t word;
+            std::memcpy(&word, data, sizeof(word));
+            crc = __crc32cd(crc, word);
+            data += 8;
+            length -= 8;
+        }
+        while (length > 0) {
+            crc = __crc32cb(crc, static_cast<uint8_t>(*data));
+            data++;
+            length--;
+        }
+        return crc ^ 0xFFFFFFFF;
+    }
+
+    const bool HAS_HARDWARE_CRC = true;
+#else
+    const bool HAS_HARDWARE_CRC = false;
+#endif
+
+}
+
+uint32_t Crc32cSoftware(const char *data, size_t length) {
+    const auto &t = CRC_TABLES.table;
+    uint32_t crc = 0xFFFFFFFF;
+
+    while (length >= 8) {
+        uint32_t low;
+        uint32_t high;
+        std::memcpy(&low, data, sizeof(low));
+        std::memcpy(&high, data + 4, sizeof(high));
+        low ^= crc;
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        data += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        crc = (crc >> 8) ^ t[0][(crc ^ static_cast<uint8_t>(*data)) & 0xFF];
+        data++;
+        length--;
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+bool Crc32cHardwareAvailable() {
+    return HAS_HARDWARE_CRC;
+}
+
+uint32_t Crc32c(const char *data, size_t length) {
+#if defined(DBENGINE_CRC32C_X86) || defined(DBENGINE_CRC32C_ARM)
+    if (HAS_HARDWARE_CRC) {
+        return Crc32cHardware(data, length);
+    }
+#endif
+    return Crc32cSoftware(data, length);
+}
+
+void StampPageChecksum(char *page_data) {
+    uint32_t checksum = Crc32c(page_data, PAGE_CHECKSUM_OFFSET);
+    std::memcpy(page_data + PAGE_CHECKSUM_OFFSET, &checksum, sizeof(checksum));
+}
+
+bool VerifyPageChecksum(const char *page_data) {
+    uint32_t stored;
+    std::memcpy(&stored, page_data + PAGE_CHECKSUM_OFFSET, sizeof(stored));
+
+    if (Crc32c(page_data, PAGE_CHECKSUM_OFFSET) == stored) {
+        return true;
+    }
+
+    // Never-written pages are all zeros, including the trailer
+    if (stored == 0) {
+        for (uint32_t i = 0; i < PAGE_CHECKSUM_OFFSET; i++) {
+            if (page_data[i] != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+}
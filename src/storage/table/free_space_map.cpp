@@ -0,0 +1,283 @@
+#include "storage/table/free_space_map.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+namespace dbengine {
+
+    FreeSpaceMap::FreeSpaceMap(BufferPool *bpm) : bpm_(bpm) {}
+
+    uint32_t FreeSpaceMap::AvailableSpace(const Page *page) {
+        return page->GetFreeSpace() + page->GetReclaimableSpace();
+    }
+
+    uint8_t FreeSpaceMap::ToCategory(uint32_t free_space) {
+        return static_cast<uint8_t>(std::min<uint32_t>(15, free_space / FSM_CATEGORY_BYTES));
+    }
+
+    bool FreeSpaceMap::Open(page_id_t first_map_page_id, const std::vector<page_id_t> &heap_page_ids) {
+        std::lock_guard<std::mutex> grow_lock(grow_latch_);
+
+        // Entries are positional: map page k holds heap pages [k, k + 1) * FSM_ENTRIES_PER_PAGE
+        std::vector<page_id_t> map_page_ids;
+        std::vector<uint8_t> categories;
+        page_id_t map_page_id = first_map_page_id;
+        while (map_page_id != INVALID_PAGE_ID) {
+            ReadPageGuard guard = bpm_->FetchPageRead(map_page_id);
+            if (!guard.IsValid()) {
+                return false;
+            }
+            const char *data = guard.GetData();
+            const FreeSpaceMapPageHeader *header = reinterpret_cast<const FreeSpaceMapPageHeader *>(data);
+            const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data + sizeof(FreeSpaceMapPageHeader));
+            size_t num_entries = std::min(FSM_ENTRIES_PER_PAGE, heap_page_ids.size() - categories.size());
+            if (header->page_id != map_page_id || header->num_entries != num_entries) {
+                return false; // Not a map page, or a map of a different number of heap pages
+            }
+            for (size_t entry = 0; entry < num_entries; entry++) {
+                uint8_t byte = bytes[entry / 2];
+                categories.push_back(static_cast<uint8_t>(entry % 2 == 0 ? byte & 0x0F : byte >> 4));
+            }
+            map_page_ids.push_back(map_page_id);
+            map_page_id = header->next_page_id;
+        }
+        if (categories.size() != heap_page_ids.size()) {
+            return false;
+        }
+
+        Load(std::move(map_page_ids), heap_page_ids, std::move(categories));
+        return true;
+    }
+
+    bool FreeSpaceMap::Rebuild(page_id_t first_map_page_id, const std::vector<page_id_t> &heap_page_ids,
+                               const std::vector<uint32_t> &free_spaces) {
+        std::lock_guard<std::mutex> grow_lock(grow_latch_);
+
+        // Collect the old chain so its pages are rewritten rather than leaked. It ends early
+        // at a page that can't be read, isn't a map page or belongs to the heap itself.
+        std::unordered_set<page_id_t> heap_pages(heap_page_ids.begin(), heap_page_ids.end());
+        std::unordered_set<page_id_t> seen;
+        std::vector<page_id_t> old_page_ids;
+        page_id_t map_page_id = first_map_page_id;
+        while (map_page_id != INVALID_PAGE_ID && heap_pages.count(map_page_id) == 0 && seen.insert(map_page_id).second) {
+            ReadPageGuard guard = bpm_->FetchPageRead(map_page_id);
+            if (!guard.IsValid()) {
+                break;
+            }
+            const FreeSpaceMapPageHeader *header = reinterpret_cast<const FreeSpaceMapPageHeader *>(guard.GetData());
+            if (header->page_id != map_page_id) {
+                break;
+            }
+            old_page_ids.push_back(map_page_id);
+            map_page_id = header->next_page_id;
+        }
+
+        // Reuse the old pages in chain order, so the first page id stays the same; extend
+        // the chain with new pages if the heap outgrew it
+        size_t num_map_pages = std::max<size_t>(1, (heap_page_ids.size() + FSM_ENTRIES_PER_PAGE - 1) / FSM_ENTRIES_PER_PAGE);
+        std::vector<page_id_t> map_page_ids(old_page_ids.begin(), old_page_ids.begin() + std::min(old_page_ids.size(), num_map_pages));
+        size_t num_reused = map_page_ids.size();
+        auto drop_new_pages = [this, &map_page_ids, num_reused]() {
+            for (size_t k = num_reused; k < map_page_ids.size(); k++) {
+                bpm_->DeletePage(map_page_ids[k]);
+            }
+        };
+        while (map_page_ids.size() < num_map_pages) {
+            page_id_t new_page_id;
+            WritePageGuard guard = bpm_->NewPageGuarded(&new_page_id);
+            if (!guard.IsValid()) {
+                drop_new_pages();
+                return false;
+            }
+            map_page_ids.push_back(new_page_id);
+        }
+
+        std::vector<uint8_t> categories(heap_page_ids.size());
+        for (size_t index = 0; index < heap_page_ids.size(); index++) {
+            categories[index] = ToCategory(free_spaces[index]);
+        }
+        for (size_t k = 0; k < num_map_pages; k++) {
+            WritePageGuard guard = bpm_->FetchPageWrite(map_page_ids[k]);
+            if (!guard.IsValid()) {
+                drop_new_pages();
+                return false;
+            }
+            char *data = guard.GetDataMut();
+            memset(data, 0, PAGE_CHECKSUM_OFFSET);
+            FreeSpaceMapPageHeader *header = reinterpret_cast<FreeSpaceMapPageHeader *>(data);
+            header->page_id = map_page_ids[k];
+            header->next_page_id = k + 1 < num_map_pages ? map_page_ids[k + 1] : INVALID_PAGE_ID;
+            uint8_t *bytes = reinterpret_cast<uint8_t *>(data + sizeof(FreeSpaceMapPageHeader));
+            size_t begin = k * FSM_ENTRIES_PER_PAGE;
+            size_t end = std::min(heap_page_ids.size(), begin + FSM_ENTRIES_PER_PAGE);
+            for (size_t index = begin; index < end; index++) {
+                size_t entry = index - begin;
+                bytes[entry / 2] |= static_cast<uint8_t>(entry % 2 == 0 ? categories[index] : categories[index] << 4);
+            }
+            header->num_entries = static_cast<uint32_t>(end - begin);
+        }
+
+        // A chain longer than the heap needs gives its tail back
+        for (size_t k = num_map_pages; k < old_page_ids.size(); k++) {
+            bpm_->DeletePage(old_page_ids[k]);
+        }
+
+        Load(std::move(map_page_ids), heap_page_ids, std::move(categories));
+        return true;
+    }
+
+    void FreeSpaceMap::Load(std::vector<page_id_t> map_page_ids, const std::vector<page_id_t> &heap_page_ids,
+                            std::vector<uint8_t> categories) {
+        std::lock_guard<std::mutex> lock(latch_);
+        map_page_ids_ = std::move(map_page_ids);
+        heap_page_ids_ = heap_page_ids;
+        categories_ = std::move(categories);
+        index_of_.clear();
+        for (size_t index = 0; index < heap_page_ids_.size(); index++) {
+            index_of_[heap_page_ids_[index]] = index;
+        }
+        search_from_.fill(0);
+    }
+
+    bool FreeSpaceMap::AddPage(page_id_t page_id, uint32_t free_space) {
+        std::lock_guard<std::mutex> grow_lock(grow_latch_);
+        size_t index;
+        size_t num_map_pages;
+        page_id_t last_map_page_id;
+        {
+            std::lock_guard<std::mutex> lock(latch_);
+            index = heap_page_ids_.size();
+            num_map_pages = map_page_ids_.size();
+            last_map_page_id = map_page_ids_.empty() ? INVALID_PAGE_ID : map_page_ids_.back();
+        }
+
+        // The last map page is full: chain a new one after it
+        if (index == num_map_pages * FSM_ENTRIES_PER_PAGE) {
+            page_id_t map_page_id;
+            WritePageGuard guard = bpm_->NewPageGuarded(&map_page_id);
+            if (!guard.IsValid()) {
+                return false;
+            }
+            char *data = guard.GetDataMut();
+            memset(data, 0, PAGE_CHECKSUM_OFFSET);
+            FreeSpaceMapPageHeader *header = reinterpret_cast<FreeSpaceMapPageHeader *>(data);
+            header->page_id = map_page_id;
+            header->next_page_id = INVALID_PAGE_ID;
+            guard.Drop();
+
+            if (last_map_page_id != INVALID_PAGE_ID) {
+                WritePageGuard prev_guard = bpm_->FetchPageWrite(last_map_page_id);
+                if (prev_guard.IsValid()) {
+                    reinterpret_cast<FreeSpaceMapPageHeader *>(prev_guard.GetDataMut())->next_page_id = map_page_id;
+                }
+            }
+            std::lock_guard<std::mutex> lock(latch_);
+            map_page_ids_.push_back(map_page_id);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(latch_);
+            heap_page_ids_.push_back(page_id);
+            categories_.push_back(0);
+            index_of_[page_id] = index;
+            SetCategory(index, ToCategory(free_space));
+        }
+        WriteEntry(index);
+        return true;
+    }
+
+    void FreeSpaceMap::Update(page_id_t page_id, uint32_t free_space) {
+        size_t index;
+        {
+            std::lock_guard<std::mutex> lock(latch_);
+            auto it = index_of_.find(page_id);
+            if (it == index_of_.end()) {
+                return;
+            }
+            uint8_t category = ToCategory(free_space);
+            if (categories_[it->second] == category) {
+                return;
+            }
+            index = it->second;
+            SetCategory(index, category);
+        }
+        WriteEntry(index);
+    }
+
+    page_id_t FreeSpaceMap::FindPage(uint32_t record_size, page_id_t skip_page_id) {
+        // Smallest category that guarantees room for the record and a new slot
+        uint32_t needed = (record_size + sizeof(Slot) + FSM_CATEGORY_BYTES - 1) / FSM_CATEGORY_BYTES;
+        if (needed > 15) {
+            return INVALID_PAGE_ID;
+        }
+
+        // Resume where the last search for this category stopped. The cursor only
+        // moves past pages with too little room, so it stays put at a skipped page.
+        std::lock_guard<std::mutex> lock(latch_);
+        size_t &cursor = search_from_[needed];
+        bool skipped = false;
+        for (size_t i = cursor; i < categories_.size(); i++) {
+            if (categories_[i] < needed) {
+                if (!skipped) {
+                    cursor = i + 1;
+                }
+                continue;
+            }
+            if (heap_page_ids_[i] == skip_page_id) {
+                skipped = true;
+                continue;
+            }
+            if (!skipped) {
+                cursor = i;
+            }
+            return heap_page_ids_[i];
+        }
+        return INVALID_PAGE_ID;
+    }
+
+    uint8_t FreeSpaceMap::GetCategory(page_id_t page_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        auto it = index_of_.find(page_id);
+        return it == index_of_.end() ? 0 : categories_[it->second];
+    }
+
+    void FreeSpaceMap::SetCategory(size_t index, uint8_t category) {
+        categories_[index] = category;
+        // A page with more room may now be the earliest fit for the smaller categories
+        for (uint8_t c = 1; c <= category; c++) {
+            search_from_[c] = std::min(search_from_[c], index);
+        }
+    }
+
+    void FreeSpaceMap::WriteEntry(size_t index) {
+        page_id_t map_page_id;
+        {
+            std::lock_guard<std::mutex> lock(latch_);
+            map_page_id = map_page_ids_[index / FSM_ENTRIES_PER_PAGE];
+        }
+
+        WritePageGuard guard = bpm_->FetchPageWrite(map_page_id);
+        if (!guard.IsValid()) {
+            return; // Only the map page misses the change: inserts consult the cached copy
+        }
+
+        // The category is read under the page latch, so when two updates of the
+        // entry race, the last one to write the page writes the latest category
+        uint8_t category;
+        {
+            std::lock_guard<std::mutex> lock(latch_);
+            category = categories_[index];
+        }
+        char *data = guard.GetDataMut();
+        FreeSpaceMapPageHeader *header = reinterpret_cast<FreeSpaceMapPageHeader *>(data);
+        size_t entry = index % FSM_ENTRIES_PER_PAGE;
+        uint8_t *byte = reinterpret_cast<uint8_t *>(data + sizeof(FreeSpaceMapPageHeader)) + entry / 2;
+        if (entry % 2 == 0) {
+            *byte = static_cast<uint8_t>((*byte & 0xF0) | category);
+        } else {
+            *byte = static_cast<uint8_t>((*byte & 0x0F) | (category << 4));
+        }
+        header->num_entries = std::max<uint32_t>(header->num_entries, static_cast<uint32_t>(entry + 1));
+    }
+}
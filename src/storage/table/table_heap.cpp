@@ -1,103 +1,186 @@
 #include "storage/table/table_heap.h"
 #include "common/config.h"
 #include <cassert>
+#include <string>
+#include <vector>
 
 namespace dbengine {
 
-    TableHeap::TableHeap(BufferPoolManager *bpm) : bpm_(bpm), first_page_id_(INVALID_PAGE_ID), last_page_id_(INVALID_PAGE_ID) {
+    // Pages taken from the free space map before an insert gives up and grows the heap
+    static constexpr int MAX_FSM_ATTEMPTS = 3;
 
-    Page *first_page = bpm_->NewPage(&first_page_id_);
+    TableHeap::TableHeap(BufferPool *bpm) : bpm_(bpm), first_page_id_(INVALID_PAGE_ID), last_page_id_(INVALID_PAGE_ID), num_pages_(1),
+        free_space_map_(bpm) {
+
+    Page *first_page = bpm_->NewPage(&first_page_id_, &extent_);
     if (first_page == nullptr) {
         throw std::runtime_error("Failed to create the first page for TableHeap");
     }
     last_page_id_ = first_page_id_;
+    uint32_t free_space = FreeSpaceMap::AvailableSpace(first_page);
     bpm_->UnpinPage(first_page_id_, false);
+    if (!free_space_map_.AddPage(first_page_id_, free_space)) {
+        throw std::runtime_error("Failed to create the free space map for TableHeap");
+    }
 
     }
 
+    TableHeap::TableHeap(BufferPool *bpm, page_id_t first_page_id, page_id_t free_space_map_page_id) : bpm_(bpm),
+        first_page_id_(first_page_id), last_page_id_(INVALID_PAGE_ID), num_pages_(0), free_space_map_(bpm) {
+
+        std::vector<page_id_t> page_ids;
+        std::vector<uint32_t> free_spaces;
+        page_id_t page_id = first_page_id_;
+        while (page_id != INVALID_PAGE_ID) {
+            ReadPageGuard guard = bpm_->FetchPageRead(page_id);
+            if (!guard.IsValid()) {
+                throw std::runtime_error("Failed to read page " + std::to_string(page_id) + " of TableHeap");
+            }
+            page_ids.push_back(page_id);
+            free_spaces.push_back(FreeSpaceMap::AvailableSpace(guard.GetPage()));
+            page_id = guard.GetPage()->GetNextPageId();
+        }
+        if (page_ids.empty()) {
+            throw std::runtime_error("TableHeap has no first page");
+        }
+        last_page_id_ = page_ids.back();
+        num_pages_ = page_ids.size();
+
+        // A map that is missing or out of step with the chain is rebuilt from the pages just read
+        if (!free_space_map_.Open(free_space_map_page_id, page_ids) &&
+            !free_space_map_.Rebuild(free_space_map_page_id, page_ids, free_spaces)) {
+            throw std::runtime_error("Failed to rebuild the free space map for TableHeap");
+        }
+    }
+
+    TableHeap::~TableHeap() {
+        bpm_->ReleaseExtent(&extent_);
+    }
+
     bool TableHeap::InsertTuple(const Tuple &tuple, RID &rid) {
 
         // Evauate whether the tuple can fit into a page.
-        if (tuple.GetSize() > PAGE_SIZE - sizeof(PageHeader) - sizeof(Slot)) {
+        if (tuple.GetSize() > PAGE_CHECKSUM_OFFSET - sizeof(PageHeader) - sizeof(Slot)) {
             return false;   
         }
 
-        Page *page = bpm_->FetchPage(last_page_id_);
-        if (page == nullptr) {
-            return false;
-        }
-
-        if (page->InsertRecord(tuple.GetData(), tuple.GetSize(), rid)) {
-            bpm_->UnpinPage(last_page_id_, true);
+        // Appends go to the last page until it fills up
+        if (InsertIntoPage(last_page_id_, tuple, rid)) {
             return true;
         }
 
-        bpm_->UnpinPage(last_page_id_, false);
+        // Then to an earlier page with room left by deletes. A page the map is wrong
+        // about gets its entry corrected by the failed attempt, and is not offered again.
+        page_id_t tried_page_id = last_page_id_;
+        for (int attempt = 0; attempt < MAX_FSM_ATTEMPTS; attempt++) {
+            page_id_t page_id = free_space_map_.FindPage(tuple.GetSize(), tried_page_id);
+            if (page_id == INVALID_PAGE_ID) {
+                break;
+            }
+            if (InsertIntoPage(page_id, tuple, rid)) {
+                return true;
+            }
+            tried_page_id = page_id;
+        }
 
-        Page *new_page = bpm_->NewPage(&last_page_id_);
-        if (new_page == nullptr) {
+        WritePageGuard guard = bpm_->FetchPageWrite(last_page_id_);
+        if (!guard.IsValid()) {
             return false;
         }
 
-        if (new_page->InsertRecord(tuple.GetData(), tuple.GetSize(), rid)) {
-            bpm_->UnpinPage(last_page_id_, true);
-            return true;
+        // Chain a new page after the current last page so scans can follow it
+        page_id_t new_page_id;
+        WritePageGuard new_guard = bpm_->NewPageGuarded(&new_page_id, &extent_);
+        if (!new_guard.IsValid()) {
+            return false;
         }
+        guard.GetPageMut()->SetNextPageId(new_page_id);
+        last_page_id_ = new_page_id;
+        num_pages_++;
+        guard.Drop();
+
+        bool inserted = new_guard.GetPageMut()->InsertRecord(tuple.GetData(), tuple.GetSize(), rid);
+        uint32_t free_space = FreeSpaceMap::AvailableSpace(new_guard.GetPage());
+        new_guard.Drop();
+        free_space_map_.AddPage(new_page_id, free_space);
+        return inserted;
+    }
 
-        bpm_->UnpinPage(last_page_id_, false);
+    bool TableHeap::InsertIntoPage(page_id_t page_id, const Tuple &tuple, RID &rid) {
+        WritePageGuard guard = bpm_->FetchPageWrite(page_id);
+        if (!guard.IsValid()) {
+            return false;
+        }
 
-        return false;
+        bool inserted = guard.GetPageMut()->InsertRecord(tuple.GetData(), tuple.GetSize(), rid);
+        uint32_t free_space = FreeSpaceMap::AvailableSpace(guard.GetPage());
+        guard.Drop();
+        free_space_map_.Update(page_id, free_space);
+        return inserted;
     }
 
     bool TableHeap::GetTuple(const RID &rid, Tuple &tuple) {
-        page_id_t page_id = rid.GetPageId();
-        Page *page = bpm_->FetchPage(page_id);
-        if (page == nullptr) {
+        ReadPageGuard guard;
+        TupleView view;
+        if (!GetTupleView(rid, guard, view)) {
             return false;
         }
 
-        tuple.Allocate(PAGE_SIZE - sizeof(PageHeader) - sizeof(Slot));
-
-        if (page->GetRecord(rid, tuple.GetData())) {
+        // Exactly the record's bytes, into the tuple's buffer if it is large enough
+        tuple.Assign(view.GetData(), view.GetSize());
+        tuple.SetRID(rid);
+        return true;
+    }
 
-            bpm_->UnpinPage(page_id, false);
-            tuple.SetRID(rid);
-            return true;
+    bool TableHeap::GetTupleView(const RID &rid, ReadPageGuard &guard, TupleView &view) {
+        // A guard already on the page is kept. Otherwise it is dropped before the fetch:
+        // assigning over it would take the new latch first, and a second shared latch on
+        // the same frame from this thread could deadlock behind a queued writer.
+        if (!guard.IsValid() || guard.GetPageId() != rid.GetPageId()) {
+            guard.Drop();
+            guard = bpm_->FetchPageRead(rid.GetPageId());
+        }
+        if (!guard.IsValid()) {
+            return false;
         }
 
-        bpm_->UnpinPage(page_id, false);
-        return false;
+        uint32_t size;
+        const char *data = guard.GetPage()->GetRecordData(rid, &size);
+        if (data == nullptr) {
+            guard.Drop();
+            return false;
+        }
+        view = TupleView(data, size, rid);
+        return true;
     }
 
     bool TableHeap::DeleteTuple(const RID &rid) {
-        page_id_t page_id = rid.GetPageId();
-        Page *page = bpm_->FetchPage(page_id);
-        if (page == nullptr) {
+        WritePageGuard guard = bpm_->FetchPageWrite(rid.GetPageId());
+        if (!guard.IsValid()) {
             return false;
         }
 
-        if (page->DeleteRecord(rid)) {
-            bpm_->UnpinPage(page_id, true);
-            return true;
+        if (!guard.GetPageMut()->DeleteRecord(rid)) {
+            return false;
         }
-
-        bpm_->UnpinPage(page_id, false);
-        return false;
+        uint32_t free_space = FreeSpaceMap::AvailableSpace(guard.GetPage());
+        guard.Drop();
+        free_space_map_.Update(rid.GetPageId(), free_space);
+        return true;
     }
 
     bool TableHeap::UpdateTuple(const Tuple &new_tuple, const RID &rid) {
-        page_id_t page_id = rid.GetPageId();
-        Page *page = bpm_->FetchPage(page_id);
-        if (page == nullptr) {
+        WritePageGuard guard = bpm_->FetchPageWrite(rid.GetPageId());
+        if (!guard.IsValid()) {
             return false;
         }
-        
-        if (page->UpdateRecord(rid, new_tuple.GetData(), new_tuple.GetSize())) {
-            bpm_->UnpinPage(page_id, true);
-            return true;
-        }
 
-        bpm_->UnpinPage(page_id, false);
-        return false;
+        if (!guard.GetPageMut()->UpdateRecord(rid, new_tuple.GetData(), new_tuple.GetSize())) {
+            return false;
+        }
+        uint32_t free_space = FreeSpaceMap::AvailableSpace(guard.GetPage());
+        guard.Drop();
+        free_space_map_.Update(rid.GetPageId(), free_space);
+        return true;
     }
 }
\ No newline at end of file
@@ -348,6 +348,32 @@ void TestStressLargeInsert() {
     PrintTestSuccess(test_name);
 }
 
+// Test 11: RIDs beyond the 32-bit page id range survive leaf splits
+void TestWidePageIds() {
+    std::string test_name = "Test 11: 64-bit Page IDs";
+    PrintTestHeader(test_name);
+
+    std::remove("test_bp_wide.db");
+    DiskManager disk_manager("test_bp_wide.db");
+    BufferPoolManager bpm(20, &disk_manager);
+    BPlusTree bpt(&bpm, 7);  // Odd size: RID array needs alignment padding
+
+    const page_id_t base_page_id = (page_id_t{1} << 40) + 3;
+    for (int32_t key = 0; key < 100; key++) {
+        bool inserted = bpt.Insert(key, RID(base_page_id + key, key % 7, 1));
+        assert(inserted && "Insert should succeed");
+    }
+    for (int32_t key = 0; key < 100; key++) {
+        RID rid;
+        bool found = bpt.Search(key, rid);
+        assert(found && "Key should be found");
+        assert(rid.GetPageId() == base_page_id + key);
+        assert(rid.GetSlotNum() == key % 7);
+    }
+
+    PrintTestSuccess(test_name);
+}
+
 int main() {
     std::cout << "\n";
     std::cout << "========================================" << std::endl;
@@ -375,6 +401,9 @@ int main() {
         // Stress test
         TestStressLargeInsert();
 
+        // Layout
+        TestWidePageIds();
+
         std::cout << "\n========================================" << std::endl;
         std::cout << "   ALL TESTS PASSED!                   " << std::endl;
         std::cout << "========================================\n" << std::endl;
@@ -1,6 +1,9 @@
 #include "storage/disk/disk_manager.h"
 #include <iostream>
+#include <cstdio>
 #include <cstring>
+#include <sys/stat.h>
+#include <vector>
 
 using namespace dbengine;
 
@@ -10,6 +13,7 @@ int main() {
     try {
         // Test 1: Create DiskManager (creates/opens file)
         std::cout << "Test 1: Create DiskManager (creates/opens file)" << std::endl;
+        std::remove("test.db");
         DiskManager disk_manager("test.db");
         std::cout << "DiskManager create successfully" << std::endl;
 
@@ -77,7 +81,335 @@ int main() {
     } catch (const std::out_of_range &e) {
         std::cout << "[Success] Caught expected out of range error: " << e.what() << std::endl;
     }
-    
+
+    // A negative id must not turn into a huge file offset
+    try {
+         char error_buffer[PAGE_SIZE];
+         disk_manager.ReadPage(-1, error_buffer);
+         std::cout << "[Failure] Negative page id should have thrown an error!" << std::endl;
+         return 1;
+    } catch (const std::out_of_range &e) {
+        std::cout << "[Success] Caught expected out of range error: " << e.what() << std::endl;
+    }
+
+    // Test 9: Batched writes and reads with many requests in flight
+    std::cout << "[Test 9] Batched WritePages/ReadPages (" << disk_manager.GetIOEngineName() << ")..." << std::endl;
+    {
+        const int batch_size = 16;
+        std::vector<std::vector<char>> write_pages(batch_size, std::vector<char>(PAGE_SIZE));
+        std::vector<std::vector<char>> read_pages(batch_size, std::vector<char>(PAGE_SIZE, 0));
+        std::vector<PageRequest> writes;
+        std::vector<PageRequest> reads;
+        for (int i = 0; i < batch_size; i++) {
+            page_id_t page_id = disk_manager.AllocatePage();
+            memset(write_pages[i].data(), 'a' + i, PAGE_SIZE);
+            writes.push_back(PageRequest{page_id, write_pages[i].data()});
+            reads.push_back(PageRequest{page_id, read_pages[i].data()});
+        }
+        disk_manager.WritePages(writes);
+
+        // Submit now, wait later
+        auto batch = disk_manager.SubmitReadPages(reads);
+        disk_manager.WaitForBatch(batch);
+        for (int i = 0; i < batch_size; i++) {
+            if (memcmp(write_pages[i].data(), read_pages[i].data(), PAGE_SIZE) != 0) {
+                std::cout << "[Failure] Batched page " << i << " mismatches!" << std::endl;
+                return 1;
+            }
+        }
+        std::cout << "[Success] Batched pages match!" << std::endl;
+    }
+
+    // Test 10: Thread pool engine reads what the default engine wrote
+    std::cout << "[Test 10] Thread pool engine..." << std::endl;
+    {
+        DiskManagerOptions options;
+        options.io_engine = IOEngineType::THREAD_POOL;
+        DiskManager pool_manager("test.db", options);
+        char pool_buffer[PAGE_SIZE];
+        pool_manager.ReadPages({PageRequest{page1, pool_buffer}});
+        if (strcmp(write_buffer, pool_buffer) != 0) {
+            std::cout << "[Failure] Thread pool engine read wrong data!" << std::endl;
+            return 1;
+        }
+        std::cout << "[Success] Thread pool engine read matches!" << std::endl;
+    }
+
+    // Test 11: Deallocated pages survive a restart and are reused
+    std::cout << "[Test 11] Persistent free page reuse..." << std::endl;
+    {
+        std::remove("test_alloc.db");
+        page_id_t freed_page;
+        {
+            DiskManager alloc_manager("test_alloc.db");
+            char page_buffer[PAGE_SIZE];
+            memset(page_buffer, 0, PAGE_SIZE);
+            for (int i = 0; i < 4; i++) {
+                alloc_manager.WritePage(alloc_manager.AllocatePage(), page_buffer);
+            }
+            freed_page = 2;
+            alloc_manager.DeallocatePage(freed_page);
+            alloc_manager.DeallocatePage(freed_page);  // Double free is ignored
+            if (alloc_manager.GetNumFreePages() != 1) {
+                std::cout << "[Failure] Expected exactly one free page!" << std::endl;
+                return 1;
+            }
+        }
+
+        DiskManager reopened_manager("test_alloc.db");
+        page_id_t reused_page = reopened_manager.AllocatePage();
+        page_id_t fresh_page = reopened_manager.AllocatePage();
+        if (reused_page != freed_page || fresh_page != 4) {
+            std::cout << "[Failure] Expected page " << freed_page << " then 4, got "
+                      << reused_page << " then " << fresh_page << std::endl;
+            return 1;
+        }
+        std::cout << "[Success] Freed page " << reused_page << " reused after restart!" << std::endl;
+    }
+
+    // Test 12: O_DIRECT mode with unaligned (bounced) and aligned (batched) buffers
+    std::cout << "[Test 12] Direct I/O..." << std::endl;
+    {
+        DiskManagerOptions options;
+        options.direct_io = true;
+        DiskManager direct_manager("test.db", options);
+        std::cout << "Direct I/O " << (direct_manager.IsDirectIO() ? "enabled" : "unsupported, using buffered I/O") << std::endl;
+
+        char unaligned_buffer[PAGE_SIZE + 1];
+        direct_manager.ReadPage(page1, unaligned_buffer + 1);
+        if (strcmp(write_buffer, unaligned_buffer + 1) != 0) {
+            std::cout << "[Failure] Direct read mismatches!" << std::endl;
+            return 1;
+        }
+
+        alignas(PAGE_SIZE) static char aligned_buffer[PAGE_SIZE];
+        direct_manager.ReadPages({PageRequest{page2, aligned_buffer}});
+        if (strcmp(write_buffer2, aligned_buffer) != 0) {
+            std::cout << "[Failure] Direct batched read mismatches!" << std::endl;
+            return 1;
+        }
+        std::cout << "[Success] Direct I/O reads match!" << std::endl;
+    }
+
+    // Test 13: Compressed pages round-trip, grow in place or move, and survive a restart
+    std::cout << "[Test 13] Compressed page storage..." << std::endl;
+    {
+        std::remove("test_compressed.db");
+        std::remove("test_compressed.db.pagemap");
+        DiskManagerOptions options;
+        options.compression = true;
+        const int num_pages = 16;
+
+        // Padded fixed-width records: mostly repeated bytes
+        auto fill_page = [](char *buffer, int seed) {
+            memset(buffer, ' ', PAGE_SIZE);
+            for (uint32_t slot = 0; slot < PAGE_SIZE / 64; slot++) {
+                snprintf(buffer + slot * 64, 64, "row-%d-%u", seed, slot);
+            }
+        };
+
+        char page_buffer[PAGE_SIZE];
+        char read_back[PAGE_SIZE];
+        char noise[PAGE_SIZE];
+        for (uint32_t i = 0; i < PAGE_SIZE; i++) {
+            noise[i] = static_cast<char>((i * 2654435761u) >> 13);
+        }
+        {
+            DiskManager compressed_manager("test_compressed.db", options);
+            for (int i = 0; i < num_pages; i++) {
+                fill_page(page_buffer, i);
+                compressed_manager.WritePage(compressed_manager.AllocatePage(), page_buffer);
+            }
+            // Incompressible data is stored raw; a later compressible version moves back
+            compressed_manager.WritePage(3, noise);
+            compressed_manager.ReadPage(3, read_back);
+            if (memcmp(noise, read_back, PAGE_SIZE) != 0) {
+                std::cout << "[Failure] Raw page mismatch!" << std::endl;
+                return 1;
+            }
+            fill_page(page_buffer, 3);
+            compressed_manager.WritePage(3, page_buffer);
+
+            // Allocated but unwritten pages read back as zeros
+            page_id_t empty_page = compressed_manager.AllocatePage();
+            compressed_manager.ReadPage(empty_page, read_back);
+            for (uint32_t i = 0; i < PAGE_SIZE; i++) {
+                if (read_back[i] != 0) {
+                    std::cout << "[Failure] Unwritten compressed page is not zeroed!" << std::endl;
+                    return 1;
+                }
+            }
+
+            if (compressed_manager.GetStoredBytes() * 4 > static_cast<uint64_t>(num_pages) * PAGE_SIZE) {
+                std::cout << "[Failure] Pages did not compress: " << compressed_manager.GetStoredBytes() << " bytes" << std::endl;
+                return 1;
+            }
+        }
+
+        DiskManager reopened_manager("test_compressed.db", options);
+        if (reopened_manager.GetNumPages() != num_pages) {
+            std::cout << "[Failure] Expected " << num_pages << " pages after restart, got "
+                      << reopened_manager.GetNumPages() << std::endl;
+            return 1;
+        }
+        std::vector<std::vector<char>> batch_buffers(num_pages, std::vector<char>(PAGE_SIZE));
+        std::vector<PageRequest> batch;
+        for (int i = 0; i < num_pages; i++) {
+            batch.push_back(PageRequest{i, batch_buffers[i].data()});
+        }
+        reopened_manager.ReadPages(batch);
+        for (int i = 0; i < num_pages; i++) {
+            fill_page(page_buffer, i);
+            if (memcmp(page_buffer, batch_buffers[i].data(), PAGE_SIZE) != 0) {
+                std::cout << "[Failure] Compressed page " << i << " mismatch after restart!" << std::endl;
+                return 1;
+            }
+        }
+
+        // A new page fills the block freed when page 3 moved
+        uint64_t stored_before = reopened_manager.GetStoredBytes();
+        fill_page(page_buffer, 100);
+        reopened_manager.WritePage(reopened_manager.AllocatePage(), page_buffer);
+        reopened_manager.Sync();
+        struct stat file_stat;
+        stat("test_compressed.db", &file_stat);
+        if (reopened_manager.GetStoredBytes() <= stored_before ||
+            static_cast<uint64_t>(file_stat.st_size) > 2 * reopened_manager.GetStoredBytes()) {
+            std::cout << "[Failure] Compressed file is larger than its blocks: " << file_stat.st_size << " bytes" << std::endl;
+            return 1;
+        }
+        std::cout << "[Success] " << num_pages + 1 << " pages stored in " << file_stat.st_size << " bytes!" << std::endl;
+    }
+
+    // Test 14: Tablespace striped over three files, reopened with the same file list
+    std::cout << "[Test 14] Multi-file tablespace..." << std::endl;
+    {
+        const std::vector<std::string> files = {"test_ts.db", "test_ts_1.db", "test_ts_2.db"};
+        for (const auto &file : files) {
+            std::remove(file.c_str());
+        }
+        DiskManagerOptions options;
+        options.tablespace_files = {files[1], files[2]};
+        const page_id_t num_pages = 4 * TABLESPACE_STRIPE_PAGES;
+
+        auto fill_page = [](char *buffer, page_id_t page_id) {
+            memset(buffer, 0, PAGE_SIZE);
+            snprintf(buffer, PAGE_SIZE, "tablespace page %lld", static_cast<long long>(page_id));
+        };
+
+        std::vector<std::vector<char>> pages(num_pages, std::vector<char>(PAGE_SIZE));
+        {
+            DiskManager tablespace_manager(files[0], options);
+            if (tablespace_manager.GetNumFiles() != 3) {
+                std::cout << "[Failure] Expected 3 tablespace files!" << std::endl;
+                return 1;
+            }
+            PageExtent extent;
+            std::vector<PageRequest> writes;
+            for (page_id_t i = 0; i < num_pages; i++) {
+                page_id_t page_id = tablespace_manager.AllocatePage(&extent);
+                fill_page(pages[i].data(), page_id);
+                writes.push_back(PageRequest{page_id, pages[i].data()});
+            }
+            // Stripes 0 and 3 share a file and are adjacent in it
+            if (tablespace_manager.GetFileIndex(0) != 0 || tablespace_manager.GetFileIndex(TABLESPACE_STRIPE_PAGES) != 1 ||
+                tablespace_manager.GetFileIndex(3 * TABLESPACE_STRIPE_PAGES) != 0) {
+                std::cout << "[Failure] Pages are not striped round-robin!" << std::endl;
+                return 1;
+            }
+            tablespace_manager.WritePagesCoalesced(writes);
+            tablespace_manager.Sync();
+        }
+
+        for (const auto &file : files) {
+            struct stat file_stat;
+            stat(file.c_str(), &file_stat);
+            if (file_stat.st_size == 0) {
+                std::cout << "[Failure] Tablespace file " << file << " is empty!" << std::endl;
+                return 1;
+            }
+        }
+
+        DiskManager reopened_manager(files[0], options);
+        if (reopened_manager.GetNumPages() != num_pages) {
+            std::cout << "[Failure] Expected " << num_pages << " pages after restart, got "
+                      << reopened_manager.GetNumPages() << std::endl;
+            return 1;
+        }
+        std::vector<std::vector<char>> read_pages(num_pages, std::vector<char>(PAGE_SIZE));
+        std::vector<PageRequest> reads;
+        for (page_id_t i = 0; i < num_pages; i++) {
+            reads.push_back(PageRequest{i, read_pages[i].data()});
+        }
+        reopened_manager.ReadPages(reads);
+        char single_page[PAGE_SIZE];
+        reopened_manager.ReadPage(num_pages - 1, single_page);
+        for (page_id_t i = 0; i < num_pages; i++) {
+            if (memcmp(pages[i].data(), read_pages[i].data(), PAGE_SIZE) != 0) {
+                std::cout << "[Failure] Tablespace page " << i << " mismatch!" << std::endl;
+                return 1;
+            }
+        }
+        if (memcmp(pages[num_pages - 1].data(), single_page, PAGE_SIZE) != 0) {
+            std::cout << "[Failure] Tablespace single page read mismatch!" << std::endl;
+            return 1;
+        }
+
+        // A single-page allocation leaves the end off a stripe boundary; the next extent
+        // still starts on one, in a single file, and the pages it skipped are reused
+        page_id_t single_page_id = reopened_manager.AllocatePage();
+        page_id_t extent_start = reopened_manager.AllocateExtent(EXTENT_SIZE);
+        if (extent_start % TABLESPACE_STRIPE_PAGES != 0 ||
+            reopened_manager.GetFileIndex(extent_start) != reopened_manager.GetFileIndex(extent_start + EXTENT_SIZE - 1)) {
+            std::cout << "[Failure] Extent " << extent_start << " is not aligned to a stripe unit!" << std::endl;
+            return 1;
+        }
+        if (reopened_manager.AllocatePage() != single_page_id + 1) {
+            std::cout << "[Failure] Pages skipped to align the extent were not reused!" << std::endl;
+            return 1;
+        }
+        std::cout << "[Success] " << num_pages << " pages striped over " << reopened_manager.GetNumFiles() << " files!" << std::endl;
+    }
+
+    // Test 15: Reads of consecutive pages into one contiguous buffer are merged
+    std::cout << "[Test 15] Merged reads..." << std::endl;
+    {
+        std::remove("test_merge.db");
+        DiskManager merge_manager("test_merge.db");
+        // Longer than two merged requests, and the last pages allocated but never written
+        const page_id_t num_pages = 2 * DiskManager::MAX_MERGED_PAGES + 10;
+        const page_id_t num_written = num_pages - 2;
+        std::vector<char> page(PAGE_SIZE);
+        for (page_id_t i = 0; i < num_pages; i++) {
+            page_id_t page_id = merge_manager.AllocatePage();
+            if (page_id < num_written) {
+                memset(page.data(), 'A' + static_cast<int>(page_id % 26), PAGE_SIZE);
+                merge_manager.WritePage(page_id, page.data());
+            }
+        }
+
+        std::vector<char> buffer(num_pages * PAGE_SIZE, 'x');
+        std::vector<PageRequest> reads;
+        for (page_id_t i = 0; i < num_pages; i++) {
+            reads.push_back(PageRequest{i, buffer.data() + i * PAGE_SIZE});
+        }
+        uint64_t reads_before = merge_manager.GetStats().pages_read;
+        merge_manager.ReadPages(reads);
+        for (page_id_t i = 0; i < num_pages; i++) {
+            char expected = i < num_written ? static_cast<char>('A' + i % 26) : 0;
+            const char *data = buffer.data() + i * PAGE_SIZE;
+            if (data[0] != expected || data[PAGE_SIZE - 1] != expected) {
+                std::cout << "[Failure] Merged read of page " << i << " mismatch!" << std::endl;
+                return 1;
+            }
+        }
+        if (merge_manager.GetStats().pages_read - reads_before != static_cast<uint64_t>(num_pages)) {
+            std::cout << "[Failure] Merged reads must still count every page!" << std::endl;
+            return 1;
+        }
+        std::cout << "[Success] " << num_pages << " pages read with merged requests!" << std::endl;
+    }
+
     std::cout << "[ALL TESTS PASSED SUCCESSFULLY!]" << std::endl;
 
     } catch (const std::exception &e) {
@@ -1,4 +1,8 @@
 #include "storage/buffer/lru_replacer.h"
+#include "storage/buffer/clock_replacer.h"
+#include "storage/buffer/lru_k_replacer.h"
+#include "storage/buffer/two_queue_replacer.h"
+#include <cstring>
 #include <iostream>
 #include <cassert>
 
@@ -94,6 +98,201 @@ void TestPinNonExistent() {
     std::cout << "✓ Pin non-existent test passed" << std::endl;
 }
 
+void TestClockSecondChance() {
+    std::cout << "=== Test 6: CLOCK Second Chance ===" << std::endl;
+
+    ClockReplacer replacer(3);
+    for (frame_id_t frame = 0; frame < 3; frame++) {
+        replacer.RecordAccess(frame, frame);
+        replacer.Unpin(frame);
+    }
+    assert(replacer.Size() == 3);
+
+    // Every bit is set: the first turn clears them, the second evicts frame 0
+    frame_id_t victim;
+    assert(replacer.Victim(&victim) == true);
+    assert(victim == 0);
+
+    // Frame 1 is used again and survives the next sweep
+    replacer.RecordAccess(1, 1);
+    assert(replacer.Victim(&victim) == true);
+    assert(victim == 2);
+
+    replacer.Pin(1);
+    assert(replacer.Size() == 0);
+    assert(replacer.Victim(&victim) == false);
+
+    std::cout << "✓ CLOCK test passed" << std::endl;
+}
+
+void TestLRUKDistance() {
+    std::cout << "=== Test 7: LRU-K Backward Distance ===" << std::endl;
+
+    LRUKReplacer replacer(4, 2);
+    // Time: 0:f0 1:f0 2:f1 3:f2 4:f2 5:f3 6:f3
+    replacer.RecordAccess(0, 100);
+    replacer.RecordAccess(0, 100);
+    replacer.RecordAccess(1, 101);
+    replacer.RecordAccess(2, 102);
+    replacer.RecordAccess(2, 102);
+    replacer.RecordAccess(3, 103);
+    replacer.RecordAccess(3, 103);
+    for (frame_id_t frame = 0; frame < 4; frame++) {
+        replacer.Unpin(frame);
+    }
+
+    // Frame 1 was used once: infinite distance, evicted first
+    frame_id_t victim;
+    assert(replacer.Victim(&victim) == true);
+    assert(victim == 1);
+
+    // Then the oldest second-to-last access
+    assert(replacer.Victim(&victim) == true);
+    assert(victim == 0);
+
+    // A new page in frame 3 starts a new history
+    replacer.Pin(3);
+    replacer.RecordAccess(3, 200);
+    replacer.Unpin(3);
+    assert(replacer.Victim(&victim) == true);
+    assert(victim == 3);
+    assert(replacer.Size() == 1);
+
+    std::cout << "✓ LRU-K test passed" << std::endl;
+}
+
+void TestTwoQueueScanResistance() {
+    std::cout << "=== Test 8: 2Q Scan Resistance ===" << std::endl;
+
+    TwoQueueReplacer replacer(8);
+    for (frame_id_t frame = 0; frame < 8; frame++) {
+        replacer.RecordAccess(frame, frame);
+        replacer.Unpin(frame);
+    }
+
+    // A1in is over its share: FIFO eviction, and page 0 goes to the ghost list
+    frame_id_t victim;
+    assert(replacer.Victim(&victim) == true);
+    assert(victim == 0);
+
+    // Page 0 comes back while remembered: it proved reuse and lands in Am
+    replacer.RecordAccess(0, 0);
+    replacer.Unpin(0);
+
+    // A scan through the rest of the pool never touches it
+    for (frame_id_t expected = 1; expected <= 5; expected++) {
+        assert(replacer.Victim(&victim) == true);
+        assert(victim == expected);
+    }
+
+    // A1in down to its share: Am's LRU end goes next
+    assert(replacer.Victim(&victim) == true);
+    assert(victim == 0);
+
+    std::cout << "✓ 2Q test passed" << std::endl;
+}
+
+void TestReplacerFactory() {
+    std::cout << "=== Test 9: Replacer Factory ===" << std::endl;
+
+    const ReplacerType types[] = {ReplacerType::LRU, ReplacerType::CLOCK, ReplacerType::LRU_K, ReplacerType::TWO_Q};
+    const char *names[] = {"LRU", "CLOCK", "LRU-K", "2Q"};
+    for (int i = 0; i < 4; i++) {
+        auto replacer = Replacer::Create(types[i], 4);
+        assert(strcmp(replacer->GetName(), names[i]) == 0);
+
+        // Every policy honours pins
+        for (frame_id_t frame = 0; frame < 4; frame++) {
+            replacer->RecordAccess(frame, frame);
+            replacer->Unpin(frame);
+        }
+        replacer->Pin(2);
+        replacer->Remove(3);
+        assert(replacer->Size() == 2);
+
+        frame_id_t first;
+        frame_id_t second;
+        frame_id_t third;
+        assert(replacer->Victim(&first) == true);
+        assert(replacer->Victim(&second) == true);
+        assert(replacer->Victim(&third) == false);
+        assert(first != 2 && second != 2 && first != 3 && second != 3 && first != second);
+    }
+
+    std::cout << "✓ Replacer factory test passed" << std::endl;
+}
+
+void TestNextVictims() {
+    std::cout << "=== Test 10: Next Victims ===" << std::endl;
+
+    const ReplacerType types[] = {ReplacerType::LRU, ReplacerType::CLOCK, ReplacerType::LRU_K, ReplacerType::TWO_Q};
+    for (ReplacerType type : types) {
+        auto replacer = Replacer::Create(type, 8);
+
+        // Mixed history: even frames accessed twice, odd frames never (read-ahead)
+        for (frame_id_t frame = 0; frame < 8; frame += 2) {
+            replacer->RecordAccess(frame, 100 + frame);
+            replacer->RecordAccess(frame, 100 + frame);
+        }
+        for (frame_id_t frame = 0; frame < 8; frame++) {
+            replacer->Unpin(frame);
+        }
+        replacer->Pin(5);
+
+        // Listing removes nothing, and predicts Victim's order exactly
+        frame_id_t listed[8];
+        size_t count = replacer->NextVictims(listed, 8);
+        assert(count == 7);
+        assert(replacer->Size() == 7);
+        assert(replacer->NextVictims(listed, 3) == 3);
+        count = replacer->NextVictims(listed, 8);
+        for (size_t i = 0; i < count; i++) {
+            frame_id_t victim;
+            assert(replacer->Victim(&victim) == true);
+            assert(victim == listed[i]);
+        }
+        assert(replacer->NextVictims(listed, 8) == 0);
+    }
+
+    std::cout << "✓ Next victims test passed" << std::endl;
+}
+
+void TestSetNumFrames() {
+    std::cout << "=== Test 11: Resized Replacer ===" << std::endl;
+
+    const ReplacerType types[] = {ReplacerType::LRU, ReplacerType::CLOCK, ReplacerType::LRU_K, ReplacerType::TWO_Q};
+    for (ReplacerType type : types) {
+        auto replacer = Replacer::Create(type, 4);
+
+        // Frames added by a grow are tracked like the first ones
+        replacer->SetNumFrames(3000);
+        for (frame_id_t frame : {1, 2999, 1500}) {
+            replacer->RecordAccess(frame, 100 + frame);
+            replacer->Unpin(frame);
+        }
+        assert(replacer->Size() == 3);
+        frame_id_t victims[3];
+        for (frame_id_t &victim : victims) {
+            assert(replacer->Victim(&victim) == true);
+        }
+        assert(replacer->Victim(&victims[0]) == false);
+        assert(victims[0] + victims[1] + victims[2] == 1 + 2999 + 1500);
+
+        // After a shrink only the remaining frames come back
+        replacer->RecordAccess(2999, 7);
+        replacer->Unpin(2999);
+        replacer->Remove(2999);
+        replacer->SetNumFrames(4);
+        replacer->RecordAccess(3, 8);
+        replacer->Unpin(3);
+        frame_id_t victim;
+        assert(replacer->Victim(&victim) == true && victim == 3);
+        assert(replacer->Size() == 0);
+    }
+
+    std::cout << "✓ Resized replacer test passed" << std::endl;
+}
+
 int main() {
     std::cout << "=== LRU Replacer Test Suite ===" << std::endl;
 
@@ -103,6 +302,12 @@ int main() {
         TestRefreshLRU();
         TestEmptyVictim();
         TestPinNonExistent();
+        TestClockSecondChance();
+        TestLRUKDistance();
+        TestTwoQueueScanResistance();
+        TestReplacerFactory();
+        TestNextVictims();
+        TestSetNumFrames();
 
         std::cout << "\n========================================" << std::endl;
         std::cout << "✓✓✓ ALL TESTS PASSED! ✓✓✓" << std::endl;
@@ -1,6 +1,7 @@
 #include "storage/page/page.h"
 #include <iostream>
 #include <cstring>
+#include <cstdio>
 
 using namespace dbengine;
 
@@ -208,6 +209,129 @@ int main() {
             return 1;
         }
 
+        // Test 13: Deleted records make room through compaction
+        PrintTestHeader("Test 13: Compaction On Insert");
+        Page compact_page;
+        compact_page.Init(3);
+
+        char filler[200];
+        RID filler_rids[64];
+        int filler_count = 0;
+        for (; filler_count < 64; filler_count++) {
+            snprintf(filler, sizeof(filler), "Filler record %d", filler_count);
+            if (!compact_page.InsertRecord(filler, sizeof(filler), filler_rids[filler_count])) {
+                break;
+            }
+        }
+        for (int i = 0; i < filler_count; i += 2) {
+            compact_page.DeleteRecord(filler_rids[i]);
+        }
+        std::cout << "  Free space: " << compact_page.GetFreeSpace() << " bytes, reclaimable: "
+                  << compact_page.GetReclaimableSpace() << " bytes" << std::endl;
+
+        // Every other record is gone: that many inserts fit again, in the reused slots
+        int reinserted = 0;
+        RID reinserted_rid;
+        while (compact_page.InsertRecord(filler, sizeof(filler), reinserted_rid)) {
+            reinserted++;
+        }
+        if (reinserted == (filler_count + 1) / 2 && compact_page.GetReclaimableSpace() == 0) {
+            std::cout << "✓ Reinserted " << reinserted << " records after compaction" << std::endl;
+        } else {
+            std::cout << "✗ Reinserted " << reinserted << " of " << (filler_count + 1) / 2 << " records" << std::endl;
+            return 1;
+        }
+
+        // The records that stayed moved, but read back under their old RIDs
+        for (int i = 1; i < filler_count; i += 2) {
+            char expected[200];
+            snprintf(expected, sizeof(expected), "Filler record %d", i);
+            if (!compact_page.GetRecord(filler_rids[i], filler) || strcmp(filler, expected) != 0) {
+                std::cout << "✗ Record " << i << " lost in compaction" << std::endl;
+                return 1;
+            }
+        }
+        std::cout << "✓ Surviving records intact" << std::endl;
+
+        // Test 14: A growing update keeps its RID
+        PrintTestHeader("Test 14: Growing Update");
+        Page update_page;
+        update_page.Init(4);
+
+        RID update_rids[8];
+        char value[400];
+        for (int i = 0; i < 8; i++) {
+            memset(value, 'a' + i, 400);
+            update_page.InsertRecord(value, 400, update_rids[i]);
+        }
+
+        // Each record doubles in turn; the dead space of the previous copies is reused
+        bool updated = true;
+        for (int round = 0; round < 4 && updated; round++) {
+            for (int i = 0; i < 8 && updated; i += 2) {
+                memset(value, 'A' + i, 400);
+                updated = update_page.UpdateRecord(update_rids[i], value, 400 - round) &&
+                          update_page.UpdateRecord(update_rids[i], value, 400);
+            }
+        }
+        char grown[800];
+        memset(grown, 'Z', 800);
+        updated = updated && update_page.DeleteRecord(update_rids[1]) &&
+                  update_page.UpdateRecord(update_rids[0], grown, 800);
+        char update_buffer[800];
+        if (updated && update_page.GetRecord(update_rids[0], update_buffer) && memcmp(update_buffer, grown, 800) == 0) {
+            std::cout << "✓ Record grew to 800 bytes under the same RID" << std::endl;
+        } else {
+            std::cout << "✗ Growing update failed" << std::endl;
+            return 1;
+        }
+
+        // Test 15: An update that cannot fit leaves the record alone
+        PrintTestHeader("Test 15: Update Too Large");
+        char huge[PAGE_SIZE / 2];
+        memset(huge, 'H', sizeof(huge));
+        if (!update_page.UpdateRecord(update_rids[2], huge, sizeof(huge)) &&
+            update_page.GetRecord(update_rids[2], update_buffer) && update_buffer[0] == 'C') {
+            std::cout << "✓ Update rejected, old record kept" << std::endl;
+        } else {
+            std::cout << "✗ Oversized update should fail without losing the record" << std::endl;
+            return 1;
+        }
+
+        // Test 16: Deleted slots are reused through the free slot chain
+        PrintTestHeader("Test 16: Free Slot Chain");
+        Page chain_page;
+        chain_page.Init(5);
+
+        RID chain_rids[10];
+        for (int i = 0; i < 10; i++) {
+            chain_page.InsertRecord("slot", 5, chain_rids[i]);
+        }
+        chain_page.DeleteRecord(chain_rids[3]);
+        chain_page.DeleteRecord(chain_rids[7]);
+
+        // Most recently deleted first, then the chain runs dry and slots are appended
+        RID reused[3];
+        bool chained = chain_page.InsertRecord("new7", 5, reused[0]) && chain_page.InsertRecord("new3", 5, reused[1]) &&
+                       chain_page.InsertRecord("new10", 6, reused[2]);
+        if (chained && reused[0].GetSlotNum() == 7 && reused[1].GetSlotNum() == 3 && reused[2].GetSlotNum() == 10 &&
+            reused[0].GetGeneration() == chain_rids[7].GetGeneration() + 1) {
+            std::cout << "✓ Reused slots 7 and 3, then appended slot 10" << std::endl;
+        } else {
+            std::cout << "✗ Free slot chain reused the wrong slots" << std::endl;
+            return 1;
+        }
+
+        // The old RIDs are stale, the new ones read the new records
+        char chain_buffer[10];
+        if (!chain_page.GetRecord(chain_rids[7], chain_buffer) && !chain_page.DeleteRecord(chain_rids[3]) &&
+            chain_page.GetRecord(reused[1], chain_buffer) && strcmp(chain_buffer, "new3") == 0) {
+            std::cout << "✓ Stale RIDs rejected after slot reuse" << std::endl;
+        } else {
+            std::cout << "✗ Stale RID still valid" << std::endl;
+            return 1;
+        }
+
         std::cout << "\n========================================" << std::endl;
         std::cout << "✓✓✓ ALL TESTS PASSED! ✓✓✓" << std::endl;
         std::cout << "========================================" << std::endl;
@@ -0,0 +1,127 @@
+#include "common/stats.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dbengine;
+
+void TestStripedCounters() {
+    std::cout << "=== Test 1: Striped Counters ===" << std::endl;
+
+    StripedCounters<3> counters;
+    assert(counters.Get(0) == 0);
+    counters.Add(0);
+    counters.Add(2, 40);
+    assert(counters.Get(0) == 1);
+    assert(counters.Get(1) == 0);
+    assert(counters.Get(2) == 40);
+
+    // Adds from many threads land on different stripes and sum exactly
+    const int num_threads = 48;
+    const int adds = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&counters]() {
+            for (int i = 0; i < adds; i++) {
+                counters.Add(1);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    assert(counters.Get(1) == static_cast<uint64_t>(num_threads) * adds);
+    assert(counters.Get(0) == 1);
+
+    std::cout << "✓ Striped counters test passed" << std::endl;
+}
+
+void TestHistogramBuckets() {
+    std::cout << "=== Test 2: Histogram Buckets ===" << std::endl;
+
+    LatencyHistogram histogram;
+    HistogramSnapshot empty = histogram.Snapshot();
+    assert(empty.count == 0);
+    assert(empty.PercentileNanos(50) == 0);
+    assert(empty.ToString() == "n=0");
+
+    histogram.Record(0);     // bucket 0
+    histogram.Record(1);     // bucket 0
+    histogram.Record(1000);  // bucket 9: [512, 1024)
+    histogram.Record(1024);  // bucket 10
+    histogram.Record(uint64_t{1} << 50);  // Past the last bucket: clamped into it
+
+    HistogramSnapshot snapshot = histogram.Snapshot();
+    assert(snapshot.count == 5);
+    assert(snapshot.buckets[0] == 2);
+    assert(snapshot.buckets[9] == 1);
+    assert(snapshot.buckets[10] == 1);
+    assert(snapshot.buckets[NUM_LATENCY_BUCKETS - 1] == 1);
+    assert(snapshot.sum_ns == 0 + 1 + 1000 + 1024 + (uint64_t{1} << 50));
+
+    std::cout << "✓ Histogram buckets test passed" << std::endl;
+}
+
+void TestPercentiles() {
+    std::cout << "=== Test 3: Percentiles ===" << std::endl;
+
+    // 99 samples around 100ns and one of 1ms
+    LatencyHistogram histogram;
+    for (int i = 0; i < 99; i++) {
+        histogram.Record(100);
+    }
+    histogram.Record(1000000);
+
+    HistogramSnapshot snapshot = histogram.Snapshot();
+    assert(snapshot.PercentileNanos(50) == 128);
+    assert(snapshot.PercentileNanos(99) == 128);
+    assert(snapshot.PercentileNanos(100) == uint64_t{1} << 20);
+    assert(snapshot.MeanNanos() == (99 * 100 + 1000000) / 100.0);
+
+    std::string line = snapshot.ToString();
+    std::cout << line << std::endl;
+    assert(line.find("n=100") == 0);
+    assert(line.find("p50<128ns") != std::string::npos);
+    assert(line.find("max<1.0ms") != std::string::npos);
+
+    std::cout << "✓ Percentiles test passed" << std::endl;
+}
+
+void TestScopedLatency() {
+    std::cout << "=== Test 4: Scoped Latency ===" << std::endl;
+
+    LatencyHistogram histogram;
+    {
+        ScopedLatency latency(&histogram);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    HistogramSnapshot snapshot = histogram.Snapshot();
+    assert(snapshot.count == 1);
+    assert(snapshot.sum_ns >= 2000000);
+
+    std::cout << "✓ Scoped latency test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Stats Test Suite ===" << std::endl;
+
+    try {
+        TestStripedCounters();
+        TestHistogramBuckets();
+        TestPercentiles();
+        TestScopedLatency();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "✓✓✓ ALL TESTS PASSED! ✓✓✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << "\n✗✗✗ TEST FAILED ✗✗✗" << std::endl;
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}